@@ -1,5 +1,9 @@
 #include <benchmark/benchmark.h>
 #include <slog/slog.hpp>
+#include <slog/escape.hpp>
+#include <slog/stacktrace.hpp>
+
+#include <vector>
 
 // Define a logger by inheriting CRTP class slog::Logger
 struct my_logger : public slog::Logger<my_logger>
@@ -28,4 +32,123 @@ static void BM_string_info_with_1_arg(benchmark::State& state) {
 }
 BENCHMARK(BM_string_info_with_1_arg);
 
+template<slog::Clock clock>
+static void BM_timestamp(benchmark::State& state) {
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(slog::now(clock));
+	}
+}
+BENCHMARK(BM_timestamp<slog::Clock::wall>);
+BENCHMARK(BM_timestamp<slog::Clock::steady>);
+BENCHMARK(BM_timestamp<slog::Clock::tsc>);
+
+static void BM_capture_stacktrace(benchmark::State& state) {
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(slog::capture_stacktrace());
+	}
+}
+BENCHMARK(BM_capture_stacktrace);
+
+// Returns the number of frames captured from depth nested calls.
+static std::size_t capture_nested_stacktrace(int depth);
+static std::size_t (*volatile nested_call)(int) = &capture_nested_stacktrace; // Prevents inlining
+
+static std::size_t capture_nested_stacktrace(int depth) {
+	if (depth == 0)
+		return slog::capture_stacktrace().size;
+	const std::size_t frames = nested_call(depth - 1);
+	benchmark::DoNotOptimize(frames); // Prevents tail calls
+	return frames;
+}
+
+// Captures a deeper stack, compare with and without SLOG_FRAME_POINTERS.
+static void BM_capture_nested_stacktrace(benchmark::State& state) {
+	std::size_t frames {0};
+	for (auto _ : state)
+	{
+		frames = capture_nested_stacktrace(32);
+	}
+	state.counters["frames"] = static_cast<double>(frames);
+}
+BENCHMARK(BM_capture_nested_stacktrace);
+
+// Writes to the null device, so that only the cost of logging is measured.
+struct null_logger : public slog::Logger<null_logger>
+{
+	static std::FILE* sink()
+	{
+#ifdef _WIN32
+		static std::FILE* file = std::fopen("NUL", "w");
+#else
+		static std::FILE* file = std::fopen("/dev/null", "w");
+#endif
+		return file;
+	}
+};
+
+static void BM_log_loop(benchmark::State& state) {
+	const std::vector<int> values(static_cast<std::size_t>(state.range(0)), 42);
+	for (auto _ : state)
+	{
+		for (std::size_t i = 0; i < values.size(); i++)
+			null_logger::info("item {} -> {}", i, values[i]);
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_log_loop)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_log_batch(benchmark::State& state) {
+	const std::vector<int> values(static_cast<std::size_t>(state.range(0)), 42);
+	std::vector<std::size_t> indices(values.size());
+	for (std::size_t i = 0; i < indices.size(); i++)
+		indices[i] = i;
+	for (auto _ : state)
+	{
+		null_logger::info_batch(indices, "item {} -> {}", [&](std::size_t i) { return std::make_tuple(i, values[i]); });
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_log_batch)->Arg(10)->Arg(100)->Arg(1000);
+
+// Repeats a message, colored or not, with a quote and a tab, until it reaches the requested size.
+static std::string make_message(std::size_t size, bool colored)
+{
+	std::string line = my_logger::to_string<slog::Level::Info>("message with \"arg\"\t{}\n", 1);
+	if (!colored)
+		line = slog::strip_ansi(line);
+	std::string message;
+	while (message.size() < size)
+		message += line;
+	message.resize(size);
+	return message;
+}
+
+static void BM_strip_ansi(benchmark::State& state) {
+	const std::string message = make_message(static_cast<std::size_t>(state.range(0)), true);
+	fmt::memory_buffer out;
+	for (auto _ : state)
+	{
+		out.clear();
+		slog::strip_ansi(message, out);
+		benchmark::DoNotOptimize(out.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_strip_ansi)->RangeMultiplier(4)->Range(16, 64 << 10);
+
+static void BM_escape_json(benchmark::State& state) {
+	const std::string message = make_message(static_cast<std::size_t>(state.range(0)), false);
+	fmt::memory_buffer out;
+	for (auto _ : state)
+	{
+		out.clear();
+		slog::escape_json(message, out);
+		benchmark::DoNotOptimize(out.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_escape_json)->RangeMultiplier(4)->Range(16, 64 << 10);
+
 BENCHMARK_MAIN();
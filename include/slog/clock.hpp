@@ -0,0 +1,198 @@
+/*****************************************************************//**
+ * @file   clock.hpp
+ * @brief  Header file - Defines clocks a logger can read its timestamps from.
+ *
+ * Every clock returns wall-clock time with a nanosecond resolution :
+ * - @c Clock::wall reads the system clock on each call,
+ * - @c Clock::steady reads the steady clock, converted to wall-clock time using a calibration,
+ * - @c Clock::tsc reads the CPU time-stamp counter, converted to wall-clock time using a
+ * calibration. It falls back to @c Clock::steady if the CPU has no invariant TSC.
+ *
+ * Calibrations are refreshed every @c calibration_period, so that adjustments of the system clock
+ * are picked up. Differences under @c max_slew are slewed over the next period, so that calibrated
+ * clocks never go backwards across a refresh. Larger ones, e.g. when the system clock is set, are
+ * stepped. The first call to a calibrated clock spends about a millisecond measuring the TSC
+ * frequency.
+ *
+ * Usage :
+\code{.cpp}
+struct my_logger : public slog::Logger<my_logger>
+{
+	static constexpr slog::Clock clock {slog::Clock::tsc};
+	static constexpr std::string_view time_format {"[{:%H:%M:%S}.{:09}]"}; // Second argument holds nanoseconds
+};
+\endcode
+ *********************************************************************/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PRIVATE_SLOG_CLOCK_TSC
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+namespace slog
+{
+    /**
+     * @brief Source of timestamps.
+     */
+    enum class Clock
+    {
+        wall,
+        steady,
+        tsc
+    };
+
+    /**
+     * @brief Wall-clock time with a nanosecond resolution.
+     */
+    using timestamp = std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>;
+
+    /**
+     * @brief Delay after which calibrations used by @c Clock::steady and @c Clock::tsc are refreshed.
+     */
+    inline constexpr std::chrono::seconds calibration_period{1};
+
+    /**
+     * @brief Largest difference with the system clock slewed over a @c calibration_period.
+     */
+    inline constexpr std::chrono::milliseconds max_slew{1};
+
+    /**
+     * @brief Returns true if the CPU time-stamp counter runs at a constant rate, i.e. if
+     * @c Clock::tsc does not fall back to @c Clock::steady.
+     */
+    bool has_invariant_tsc();
+
+    namespace impl
+    {
+        /**
+         * @brief Converts steady time and ticks, sampled at an instant, to wall-clock time.
+         */
+        struct Calibration
+        {
+            std::int64_t steady_ns{0};
+            std::int64_t steady_wall_ns{0};
+            double steady_rate{1.0}; // Wall-clock nanoseconds per steady nanosecond
+            std::uint64_t ticks{0};
+            std::int64_t ticks_wall_ns{0};
+            double ns_per_tick{0.0};
+            std::int64_t period_ticks{0}; // 0 without an invariant TSC
+        };
+
+        /**
+         * @brief Latest calibration, published with a sequence lock : the sequence is odd while a
+         * refresh writes the calibration, and 0 until the first one.
+         */
+        class PublishedCalibration
+        {
+            static constexpr std::size_t word_count{sizeof(Calibration) / sizeof(std::uint64_t)};
+            static_assert(sizeof(Calibration) == word_count * sizeof(std::uint64_t));
+
+          public:
+            /**
+             * @brief Copies the calibration, returns false if there is none or if it was being written.
+             */
+            bool load(Calibration &calibration) const
+            {
+                const unsigned int begin = sequence.load(std::memory_order_acquire);
+                std::uint64_t copy[word_count];
+                for (std::size_t i = 0; i < word_count; i++)
+                    copy[i] = words[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (begin == 0 || begin % 2 != 0 || sequence.load(std::memory_order_relaxed) != begin)
+                    return false;
+                std::memcpy(&calibration, copy, sizeof(Calibration));
+                return true;
+            }
+
+            /**
+             * @brief Publishes a calibration. Writers must be serialized.
+             */
+            void store(const Calibration &calibration)
+            {
+                std::uint64_t copy[word_count];
+                std::memcpy(copy, &calibration, sizeof(Calibration));
+                const unsigned int begin = sequence.load(std::memory_order_relaxed);
+                sequence.store(begin + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                for (std::size_t i = 0; i < word_count; i++)
+                    words[i].store(copy[i], std::memory_order_relaxed);
+                sequence.store(begin + 2, std::memory_order_release);
+            }
+
+          private:
+            std::atomic<unsigned int> sequence{0};
+            std::atomic<std::uint64_t> words[word_count]{};
+        };
+
+        inline PublishedCalibration calibration;
+
+        inline constexpr std::int64_t period_ns{
+            std::chrono::duration_cast<std::chrono::nanoseconds>(calibration_period).count()};
+
+        /**
+         * @brief Calibrates clocks if the current calibration is missing or older than a period.
+         */
+        void refresh_calibration();
+
+        inline std::int64_t steady_ns()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+
+        inline std::uint64_t ticks()
+        {
+#if defined(PRIVATE_SLOG_CLOCK_TSC) && defined(_MSC_VER) && !defined(__clang__)
+            return __rdtsc();
+#elif defined(PRIVATE_SLOG_CLOCK_TSC)
+            return __builtin_ia32_rdtsc();
+#else
+            return 0;
+#endif
+        }
+    } // namespace impl
+
+    /**
+     * @brief Returns current wall-clock time, as measured by @c clock.
+     */
+    inline timestamp now(Clock clock)
+    {
+        using std::chrono::nanoseconds;
+
+        if (clock == Clock::wall)
+            return std::chrono::time_point_cast<nanoseconds>(std::chrono::system_clock::now());
+
+        impl::Calibration calibration;
+        if (impl::calibration.load(calibration))
+        {
+            if (clock == Clock::tsc && calibration.period_ticks != 0)
+            {
+                const auto elapsed = static_cast<std::int64_t>(impl::ticks() - calibration.ticks);
+                if (elapsed < calibration.period_ticks)
+                    return timestamp{nanoseconds{calibration.ticks_wall_ns +
+                                                 static_cast<std::int64_t>(static_cast<double>(elapsed) *
+                                                                           calibration.ns_per_tick)}};
+            }
+            else
+            {
+                const std::int64_t elapsed = impl::steady_ns() - calibration.steady_ns;
+                if (elapsed < impl::period_ns)
+                    return timestamp{nanoseconds{calibration.steady_wall_ns +
+                                                 static_cast<std::int64_t>(static_cast<double>(elapsed) *
+                                                                           calibration.steady_rate)}};
+            }
+        }
+        impl::refresh_calibration();
+        return now(clock);
+    }
+} // namespace slog
@@ -0,0 +1,45 @@
+/*****************************************************************//**
+ * @file   escape.hpp
+ * @brief  Header file - Defines helpers to post-process formatted messages.
+ *
+ * Both helpers scan the message for the next byte needing work with vectorized kernels
+ * (AVX2 or SSE2 when available, picked at runtime), then copy untouched runs in bulk.
+ *
+ * Usage :
+\code{.cpp}
+std::string message = my_logger::to_string<slog::Level::Info>("my message {}", arg);
+
+std::string plain = slog::strip_ansi(message);     // Without fmt::text_style escape codes
+std::string json  = slog::escape_json(plain);      // Ready to be put between quotes
+\endcode
+ *********************************************************************/
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+namespace slog
+{
+    /**
+     * @brief Appends @c in to @c out, without ANSI escape sequences (e.g. colors set by a
+     * @c fmt::text_style).
+     */
+    void strip_ansi(std::string_view in, fmt::memory_buffer &out);
+
+    /**
+     * @brief Returns @c in without ANSI escape sequences.
+     */
+    std::string strip_ansi(std::string_view in);
+
+    /**
+     * @brief Appends @c in to @c out, escaped to be used as the content of a JSON string.
+     */
+    void escape_json(std::string_view in, fmt::memory_buffer &out);
+
+    /**
+     * @brief Returns @c in escaped to be used as the content of a JSON string.
+     */
+    std::string escape_json(std::string_view in);
+} // namespace slog
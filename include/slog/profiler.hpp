@@ -0,0 +1,97 @@
+/*****************************************************************//**
+ * @file   profiler.hpp
+ * @brief  Header file - Defines a profiler measuring the cost of each logging statement.
+ *
+ * When @c SLOG_PROFILE is defined, each logging statement records the number of messages it logged,
+ * bytes written and time spent formatting and writing. Statements are identified by their file, line,
+ * logger and level : statements sharing a format string are counted apart.
+ *
+ * At exit, most expensive call sites are written to @c stderr as CSV.
+ *
+ * Usage :
+\code{.cpp}
+// Build with -DSLOG_PROFILE (or cmake -DSLOG_PROFILE=ON)
+my_logger::info("item {} -> {}", i, v);
+
+// Anytime
+slog::profiler::write_csv(stdout);
+\endcode
+ *********************************************************************/
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace slog
+{
+    namespace profiler
+    {
+        /**
+         * @brief Logging statement, as identified by the profiler.
+         */
+        struct CallSite
+        {
+            const char *file;
+            unsigned line;
+            std::string_view format;
+            std::string_view logger;
+            std::size_t level;
+        };
+
+        /**
+         * @brief Counters of one call site. A batch counts one message per element.
+         */
+        struct Entry
+        {
+            const char *file;
+            unsigned line;
+            std::string_view logger;
+            std::size_t level;
+            const char *format; // Copy of the call site's format string, at most max_format_size characters
+            std::uint64_t messages;
+            std::uint64_t bytes;
+            std::uint64_t ns;
+        };
+
+        /**
+         * @brief Maximum number of distinct call sites. Further call sites are gathered in a single entry.
+         */
+        inline constexpr std::size_t capacity{1024};
+
+        /**
+         * @brief Characters of a call site's format string kept by the profiler.
+         */
+        inline constexpr std::size_t max_format_size{127};
+
+        /**
+         * @brief Records @c messages logged by a call site. Lock-free once the call site is recorded.
+         *
+         * The call site's file must have a static storage duration, e.g. from @c __builtin_FILE. Its format
+         * string is copied the first time it is recorded.
+         */
+        void record(const CallSite &site, std::size_t messages, std::size_t bytes, std::chrono::nanoseconds time);
+
+        /**
+         * @brief Returns the counters of each call site, most expensive first.
+         */
+        std::vector<Entry> snapshot();
+
+        /**
+         * @brief Writes the @c count most expensive call sites to @c stream as CSV.
+         */
+        void write_csv(std::FILE *stream, std::size_t count = capacity);
+    } // namespace profiler
+
+    namespace impl
+    {
+#ifdef SLOG_PROFILE
+        inline constexpr bool profile_call_sites{true};
+#else
+        inline constexpr bool profile_call_sites{false};
+#endif
+    } // namespace impl
+} // namespace slog
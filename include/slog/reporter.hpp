@@ -6,9 +6,13 @@
  * @date   January 2024
  *********************************************************************/
 
+#include <cstdio>
+
 #include <fmt/color.h>
 #include <fmt/format.h>
 
+#include <slog/stats.hpp>
+
 
 namespace slog
 {
@@ -18,7 +22,15 @@ namespace slog
         NumericalConsoleReporter(const char *title);
 
         void add_line(const char *name, float begin, float end);
-        void print();
+
+        /**
+         * @brief Adds one line per counter, comparing two snapshots of a logger's counters.
+         *
+         * Passing the deltas of two consecutive intervals (see @c Stats::operator-) shows how
+         * logging cost evolved from one interval to the next.
+         */
+        void add_stats(const Stats &begin, const Stats &end);
+        void print(std::FILE *stream = stdout);
 
       private:
         unsigned int line_count{0};
@@ -30,4 +42,27 @@ namespace slog
         static constexpr fmt::rgb even_line_color{fmt::rgb(20, 20, 20)};
         static constexpr fmt::rgb odd_line_color{fmt::rgb(40, 40, 40)};
     };
+
+    /**
+     * @brief Prints how logging cost evolves, interval after interval.
+     *
+     * Each call to @c report() prints the counters' deltas over the interval since the last call,
+     * next to the deltas of the interval before.
+     */
+    class StatsReporter
+    {
+      public:
+        explicit StatsReporter(const char *name, Stats (*snapshot)() = &slog::stats);
+
+        /**
+         * @brief Prints the last interval's deltas next to the previous ones to @c stream, and returns them.
+         */
+        Stats report(std::FILE *stream = stdout);
+
+      private:
+        const char *title;
+        Stats (*source)();
+        Stats last;
+        Stats last_delta;
+    };
 } // namespace slog
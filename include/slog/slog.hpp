@@ -50,12 +50,27 @@ slog_assert(my_logger, false, "Abort if false {}", arg);
  *********************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include <fmt/color.h>
 #include <fmt/format.h>
 #include <fmt/chrono.h>
 
+#include <slog/clock.hpp>
+#include <slog/profiler.hpp>
+#include <slog/stacktrace.hpp>
+#include <slog/stats.hpp>
+
 
 // ------------------------------------------------------------------------------
 // --- Macros
@@ -292,7 +307,7 @@ slog_assert(my_logger, false, "Abort if false {}", arg);
 		fmt::bg(Self::prefix##_bg) | fmt::fg(Self::prefix##_fg) :\
 		fmt::fg(Self::prefix##_fg)\
 	};\
-	fmt::format_to(std::back_inserter(out), level_style, Self::level_format, name);\
+	out = fmt::format_to(out, level_style, Self::level_format, name);\
 	if constexpr (Self::inherit_level_style)\
 		_message_style  = Self::level_style;\
 	else if constexpr (Self::propagate_level_fg)\
@@ -300,6 +315,15 @@ slog_assert(my_logger, false, "Abort if false {}", arg);
 	else if constexpr (Self::propagate_level_bg)\
 		_message_style  |=  fmt::bg(Self::prefix##_bg)
 
+/**
+ * \brief Private macro do not use ! Forces inlining of entry points, so that a stack trace captured from them
+ * starts at the caller's frame.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+#define PRIVATE_SLOG_ALWAYS_INLINE __forceinline
+#else
+#define PRIVATE_SLOG_ALWAYS_INLINE __attribute__((always_inline)) inline
+#endif
 
 // ------------------------------------------------------------------------------
 // --- Classes
@@ -324,6 +348,219 @@ namespace slog
 		Debug	
 	};
 
+	/**
+	 * \brief Format string of a logging statement, along with the statement's location.
+	 *
+	 * Built implicitly from any string convertible to \c fmt::string_view. File and line default to the
+	 * statement calling the logger, and identify it when profiling call sites.
+	 */
+	struct Format
+	{
+		template <typename String, typename = std::enable_if_t<!std::is_same_v<String, Format> && std::is_convertible_v<const String&, fmt::string_view>>>
+		Format(const String& format, const char* file_name = __builtin_FILE(), unsigned line_number = __builtin_LINE()) :
+			text {format}, file {file_name}, line {line_number}
+		{}
+
+		operator fmt::string_view() const
+		{
+			return text;
+		}
+
+		fmt::string_view text;
+		const char* file;
+		unsigned line;
+	};
+
+	namespace impl
+	{
+		/**
+		 * \brief Default projector of \c Logger::batch : elements are formatted as is.
+		 */
+		struct identity
+		{
+			template<typename T>
+			constexpr T&& operator()(T&& value) const noexcept
+			{
+				return std::forward<T>(value);
+			}
+		};
+
+		/**
+		 * \brief Stands for the stack trace of a message not showing one.
+		 */
+		struct no_stacktrace {};
+
+		template<typename T>
+		struct is_tuple : std::false_type {};
+
+		template<typename... Ts>
+		struct is_tuple<std::tuple<Ts...>> : std::true_type {};
+
+		/**
+		 * \brief Stack trace captured by \c Logger::log, handed over to the \c format_to call formatting the
+		 * message while in scope. Entry points are inlined in the caller, \c format_to may not be.
+		 */
+		class PendingStacktrace
+		{
+		public:
+			explicit PendingStacktrace(const Stacktrace& stacktrace) : previous{std::exchange(pending, &stacktrace)} {}
+			~PendingStacktrace() { pending = previous; }
+			PendingStacktrace(PendingStacktrace const&) = delete;
+			void operator=(PendingStacktrace const&) = delete;
+
+			/**
+			 * \brief Returns the pending stack trace, or \c nullptr, so that only one message uses it.
+			 */
+			static const Stacktrace* take()
+			{
+				return std::exchange(pending, nullptr);
+			}
+
+		private:
+			static inline thread_local const Stacktrace* pending {nullptr};
+			const Stacktrace* previous;
+		};
+
+		/**
+		 * \brief Container-like buffer writing characters to a stream each time \c Size characters are pushed.
+		 *
+		 * Used with \c std::back_inserter, so that a message is written chunk by chunk. The chunk is allocated
+		 * on the heap, so that \c Size is not limited by the logging thread's stack. The stream stays locked
+		 * while the buffer is alive, so that chunks of other threads' messages are not interleaved.
+		 */
+		template<std::size_t Size>
+		class ChunkedStream
+		{
+		public:
+			using value_type = char;
+
+			explicit ChunkedStream(std::FILE* sink) : stream{sink}
+			{
+#ifdef _WIN32
+				_lock_file(stream);
+#else
+				flockfile(stream);
+#endif
+			}
+
+			~ChunkedStream()
+			{
+#ifdef _WIN32
+				_unlock_file(stream);
+#else
+				funlockfile(stream);
+#endif
+			}
+
+			ChunkedStream(ChunkedStream const&) = delete;
+			void operator=(ChunkedStream const&) = delete;
+
+			void push_back(char c)
+			{
+				chunk[size++] = c;
+				if (size == Size)
+					flush();
+			}
+
+			void append(const char* begin, const char* end)
+			{
+				while (begin != end)
+				{
+					const std::size_t count = std::min(static_cast<std::size_t>(end - begin), Size - size);
+					std::copy(begin, begin + count, chunk.get() + size);
+					begin += count;
+					size += count;
+					if (size == Size)
+						flush();
+				}
+			}
+
+			void flush()
+			{
+				fmt::print(stream, "{}", fmt::string_view{chunk.get(), size});
+				written += size;
+				size = 0;
+			}
+
+			std::size_t bytes_written() const
+			{
+				return written + size;
+			}
+
+		private:
+			std::FILE* stream;
+			std::unique_ptr<char[]> chunk {new char[Size]};
+			std::size_t size {0};
+			std::size_t written {0};
+		};
+
+		/**
+		 * \brief Output iterator holding back an incomplete UTF-8 sequence until its last byte is written.
+		 *
+		 * Used with \c fmt::format_to_n, so that a truncated message does not end in the middle of a code
+		 * point : the sequence still held back when the message is truncated is dropped.
+		 */
+		template<typename OutputIt>
+		class Utf8Writer
+		{
+		public:
+			using iterator_category = std::output_iterator_tag;
+			using value_type = void;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = void;
+
+			explicit Utf8Writer(OutputIt output) : out{output} {}
+
+			Utf8Writer& operator*() { return *this; }
+			Utf8Writer& operator++() { return *this; }
+			Utf8Writer& operator++(int) { return *this; }
+
+			Utf8Writer& operator=(char c)
+			{
+				const auto byte = static_cast<unsigned char>(c);
+				if ((byte & 0xC0) == 0x80 && held != 0)
+				{
+					sequence[held++] = c;
+					if (held == expected)
+						release();
+					return *this;
+				}
+
+				// Lead byte of a new sequence : an unfinished one is invalid anyway, written as is.
+				release();
+				expected = byte < 0xC0 ? 1 : byte < 0xE0 ? 2 : byte < 0xF0 ? 3 : 4;
+				if (expected == 1)
+					*out++ = c;
+				else
+					sequence[held++] = c;
+				return *this;
+			}
+
+			/**
+			 * \brief Returns the underlying iterator, after writing the held back sequence unless it is dropped.
+			 */
+			OutputIt finish(bool drop)
+			{
+				if (drop)
+					held = 0;
+				release();
+				return out;
+			}
+
+		private:
+			void release()
+			{
+				out = std::copy(sequence, sequence + held, out);
+				held = 0;
+			}
+
+			OutputIt out;
+			char sequence[4];
+			std::size_t held {0};
+			std::size_t expected {1};
+		};
+	}
 
 	/**
 	 * @brief CTRP template class that implements necessary functions to log.
@@ -375,60 +612,109 @@ slog_assert(my_logger, false, "Abort if false {}", arg);
 	template<typename Self>
 	struct Logger
 	{
-		template <typename Input, typename... Args>
-		static void fatal(Input&& fmt, Args... args)
+		template <typename... Args>
+		PRIVATE_SLOG_ALWAYS_INLINE static void fatal(Format fmt, Args... args)
 		{
 #ifndef NO_SLOG_LOG
-			log<Level::Fatal>(std::forward<Input>(fmt), std::forward<Args>(args)...);
+			log<Level::Fatal>(fmt, std::forward<Args>(args)...);
 #endif
 		}
 
-		template <typename Input, typename... Args>
-		static void error(Input fmt, Args... args)
+		template <typename... Args>
+		PRIVATE_SLOG_ALWAYS_INLINE static void error(Format fmt, Args... args)
 		{
 #ifndef NO_SLOG_LOG
 			log<Level::Error>(fmt, std::forward<Args>(args)...);
 #endif
 		}
 
-		template <typename Input, typename... Args>
-		static void warn(Input fmt, Args... args)
+		template <typename... Args>
+		PRIVATE_SLOG_ALWAYS_INLINE static void warn(Format fmt, Args... args)
 		{
 #ifndef NO_SLOG_LOG
 			log<Level::Warn>(fmt, std::forward<Args>(args)...);
 #endif
 		}
 
-		template <typename Input, typename... Args>
-		static void success(Input fmt, Args... args)
+		template <typename... Args>
+		PRIVATE_SLOG_ALWAYS_INLINE static void success(Format fmt, Args... args)
 		{
 #ifndef NO_SLOG_LOG
 			log<Level::Success>(fmt, std::forward<Args>(args)...);
 #endif
 		}
 
-		template <typename Input, typename... Args>
-		static void info(Input fmt, Args... args)
+		template <typename... Args>
+		PRIVATE_SLOG_ALWAYS_INLINE static void info(Format fmt, Args... args)
 		{
 #ifndef NO_SLOG_LOG
 			log<Level::Info>(fmt, std::forward<Args>(args)...);
 #endif
 		}
 
-		template <typename Input, typename... Args>
-		static void debug(Input fmt, Args... args)
+		template <typename... Args>
+		PRIVATE_SLOG_ALWAYS_INLINE static void debug(Format fmt, Args... args)
 		{
 #ifndef NO_SLOG_LOG
 			log<Level::Debug>(fmt, std::forward<Args>(args)...);
 #endif
 		}
 
+		template <typename Range, typename Projector = impl::identity>
+		PRIVATE_SLOG_ALWAYS_INLINE static void fatal_batch(const Range& range, Format fmt, Projector&& projector = {})
+		{
+#ifndef NO_SLOG_LOG
+			batch<Level::Fatal>(range, fmt, std::forward<Projector>(projector));
+#endif
+		}
+
+		template <typename Range, typename Projector = impl::identity>
+		PRIVATE_SLOG_ALWAYS_INLINE static void error_batch(const Range& range, Format fmt, Projector&& projector = {})
+		{
+#ifndef NO_SLOG_LOG
+			batch<Level::Error>(range, fmt, std::forward<Projector>(projector));
+#endif
+		}
+
+		template <typename Range, typename Projector = impl::identity>
+		PRIVATE_SLOG_ALWAYS_INLINE static void warn_batch(const Range& range, Format fmt, Projector&& projector = {})
+		{
+#ifndef NO_SLOG_LOG
+			batch<Level::Warn>(range, fmt, std::forward<Projector>(projector));
+#endif
+		}
+
+		template <typename Range, typename Projector = impl::identity>
+		PRIVATE_SLOG_ALWAYS_INLINE static void success_batch(const Range& range, Format fmt, Projector&& projector = {})
+		{
+#ifndef NO_SLOG_LOG
+			batch<Level::Success>(range, fmt, std::forward<Projector>(projector));
+#endif
+		}
+
+		template <typename Range, typename Projector = impl::identity>
+		PRIVATE_SLOG_ALWAYS_INLINE static void info_batch(const Range& range, Format fmt, Projector&& projector = {})
+		{
+#ifndef NO_SLOG_LOG
+			batch<Level::Info>(range, fmt, std::forward<Projector>(projector));
+#endif
+		}
+
+		template <typename Range, typename Projector = impl::identity>
+		PRIVATE_SLOG_ALWAYS_INLINE static void debug_batch(const Range& range, Format fmt, Projector&& projector = {})
+		{
+#ifndef NO_SLOG_LOG
+			batch<Level::Debug>(range, fmt, std::forward<Projector>(projector));
+#endif
+		}
+
 		// --- TIME ---
 		static constexpr bool show_time {true};
 		static constexpr bool show_time_bg {false};
 		static constexpr fmt::rgb time_bg {20,20,20};
 		static constexpr fmt::rgb time_fg {100,100,100};
-		static constexpr std::string_view time_format {"[{:%H:%M:%S}]"};
+		static constexpr std::string_view time_format {"[{:%H:%M:%S}]"}; // Arguments : local time, nanoseconds
+		static constexpr Clock clock {Clock::wall};
 
 
 		// --- LOGGER ---
@@ -481,28 +767,266 @@ slog_assert(my_logger, false, "Abort if false {}", arg);
 		static constexpr bool propagate_level_fg {true};
 		static constexpr bool propagate_level_bg {false};
 
+		static constexpr std::size_t max_message_size {0}; // Characters kept from the formatted message, 0 if unlimited
+		static constexpr std::string_view truncation_marker {" [...]"};
+
+		// --- STACKTRACE ---
+		static constexpr bool show_stacktrace {true}; // Append return addresses to messages, see stacktrace.hpp
+		static constexpr Level stacktrace_level {Level::Fatal}; // Least severe level showing a stack trace
+
+		// --- SINK ---
+		/**
+		 * \brief Returns the stream messages are written to. Override it to log elsewhere than \c stdout.
+		 * Must not return \c nullptr.
+		 *
+		 * Each message is written by a single call, or chunk by chunk if \c stream_messages is true. Writes go
+		 * through stdio buffering, and block the logging thread whenever the stream blocks.
+		 */
+		static std::FILE* sink()
+		{
+			return stdout;
+		}
+
+		/**
+		 * \brief Flushes messages still buffered by \c sink().
+		 */
+		static void flush()
+		{
+			std::fflush(Self::sink());
+		}
+
+		/**
+		 * \brief If true, messages are written to \c sink() every \c chunk_size characters while being formatted,
+		 * instead of being written once fully formatted. Memory used stays bounded whatever the message's size.
+		 * The stream stays locked until the message is written : other threads writing to it wait meanwhile.
+		 */
+		static constexpr bool stream_messages {false};
+		static constexpr std::size_t chunk_size {4096};
+
+		// --- STATS ---
+		static constexpr bool collect_stats {false};
+
+		/**
+		 * \brief Returns a snapshot of this logger's counters. Counters stay at zero unless
+		 * \c collect_stats is true.
+		 */
+		static Stats stats()
+		{
+			return counters().snapshot();
+		}
+
 		Logger() = delete;
 		Logger(Logger const&) = delete;
 		void operator=(Logger const&) = delete;
 
-		template <Level level, typename Input, typename... Args>
-		static void log(Input&& fmt, Args&&... args)
+		/**
+		 * \brief Formats a message through \c Self::to_string, or \c Self::format_to if \c stream_messages is true,
+		 * and writes it to \c sink().
+		 */
+		template <Level level, typename... Args>
+		PRIVATE_SLOG_ALWAYS_INLINE static void log(Format fmt, Args&&... args)
 		{
 #ifndef NO_SLOG_LOG
-			if constexpr(Self::add_new_line)
-				fmt::print("{}\n", Self::template to_string<level>(std::forward<Input>(fmt), std::forward<Args>(args)...));
+			const auto format_message = [&](auto& out) -> std::size_t {
+				if constexpr (Self::stream_messages)
+					Self::template format_to<level>(std::back_inserter(out), fmt, std::forward<Args>(args)...);
+				else
+					out = Self::template to_string<level>(fmt, std::forward<Args>(args)...);
+				if constexpr (Self::add_new_line)
+					out.push_back('\n');
+				return 1;
+			};
+
+			if constexpr (shows_stacktrace(level))
+			{
+				const Stacktrace stacktrace = slog::capture_stacktrace();
+				const impl::PendingStacktrace pending {stacktrace};
+				write<level>(fmt, format_message);
+			}
 			else
-				fmt::print("{}", Self::template to_string<level>(std::forward<Input>(fmt), std::forward<Args>(args)...));
+			{
+				write<level>(fmt, format_message);
+			}
 #endif
 		}
 
-		template <Level level, typename Input, typename... Args>
-		static std::string to_string(Input&& fmt, Args&&... args)
+		/**
+		 * \brief Returns a message, prefixed according to this logger's parameters, formatted through \c Self::format_to.
+		 */
+		template <Level level, typename... Args>
+		PRIVATE_SLOG_ALWAYS_INLINE static std::string to_string(Format fmt, Args&&... args)
 		{
 #ifndef NO_SLOG_LOG
 			// Our subsequent characters will be inserted into this.
-			fmt::memory_buffer out;
+			std::string out;
+			Self::template format_to<level>(std::back_inserter(out), fmt, std::forward<Args>(args)...);
+			return out;
+#else
+			return {};
+#endif
+		}
 
+		/**
+		 * \brief Formats a message, prefixed according to this logger's parameters, into \c out.
+		 *
+		 * \return An iterator past the end of the formatted message.
+		 */
+		template <Level level, typename OutputIt, typename... Args>
+		PRIVATE_SLOG_ALWAYS_INLINE static OutputIt format_to(OutputIt out, Format fmt, Args&&... args)
+		{
+#ifndef NO_SLOG_LOG
+			if constexpr (shows_stacktrace(level))
+			{
+				// Messages written by log() come with the stack trace captured from the caller's frame.
+				if (const Stacktrace* pending = impl::PendingStacktrace::take())
+					return format_with<level>(out, *pending, fmt, std::forward<Args>(args)...);
+				return format_with<level>(out, slog::capture_stacktrace(), fmt, std::forward<Args>(args)...);
+			}
+			else
+			{
+				out = format_with<level>(out, impl::no_stacktrace {}, fmt, std::forward<Args>(args)...);
+			}
+#endif
+			return out;
+		}
+
+		/**
+		 * \brief Logs one message per element of \c range, formatted with the arguments returned by \c projector.
+		 *
+		 * \c projector returns either a single argument or a \c std::tuple of arguments. Any other value, including a
+		 * \c std::pair, is a single argument. Elements share a single prefix, including the timestamp, and are written
+		 * to \c sink() at once, or chunk by chunk if \c stream_messages is true. If shown, the stack trace is captured
+		 * once and appended to each message. Each element counts as a message in stats and profiles.
+		 *
+		 * Usage:
+\code{.cpp}
+std::vector<int> values {4, 8, 15};
+my_logger::batch<slog::Level::Info>(values, "value {}");
+my_logger::info_batch(std::views::iota(0, 3), "item {} -> {}", [&](int i){ return std::make_tuple(i, values[i]); });
+\endcode
+		 */
+		template <Level level, typename Range, typename Projector = impl::identity>
+		PRIVATE_SLOG_ALWAYS_INLINE static void batch(const Range& range, Format fmt, Projector&& projector = {})
+		{
+#ifndef NO_SLOG_LOG
+			if constexpr (shows_stacktrace(level))
+				write_batch<level>(slog::capture_stacktrace(), range, fmt, projector);
+			else
+				write_batch<level>(impl::no_stacktrace {}, range, fmt, projector);
+#endif
+		}
+
+	private:
+		static constexpr bool shows_stacktrace(Level level)
+		{
+			return Self::show_stacktrace && level <= Self::stacktrace_level;
+		}
+
+		/**
+		 * \brief Writes messages to \c sink() and records them in stats and profiles.
+		 *
+		 * \c format_messages appends messages to the container it is given and returns their count. The container is
+		 * a \c std::string written at once, or a stream written chunk by chunk if \c stream_messages is true.
+		 */
+		template <Level level, typename Formatter>
+		static void write([[maybe_unused]] const Format& fmt, Formatter&& format_messages)
+		{
+			using steady_clock = std::chrono::steady_clock;
+			constexpr bool timed {Self::collect_stats || impl::profile_call_sites};
+			[[maybe_unused]] const auto start = timed ? steady_clock::now() : steady_clock::time_point{};
+			[[maybe_unused]] auto formatted = start;
+			[[maybe_unused]] std::size_t bytes {0};
+			[[maybe_unused]] std::size_t count {0};
+
+			if constexpr (Self::stream_messages)
+			{
+				impl::ChunkedStream<Self::chunk_size> stream {Self::sink()};
+				count = format_messages(stream);
+				stream.flush();
+				bytes = stream.bytes_written();
+
+				// Formatting and writing are interleaved, all is accounted as formatting time.
+				if constexpr (timed)
+					formatted = steady_clock::now();
+			}
+			else
+			{
+				std::string out;
+				count = format_messages(out);
+				bytes = out.size();
+
+				if constexpr (timed)
+					formatted = steady_clock::now();
+				fmt::print(Self::sink(), "{}", out);
+			}
+
+			if constexpr (timed)
+			{
+				const auto end = Self::stream_messages ? formatted : steady_clock::now();
+				if constexpr (Self::collect_stats)
+					counters_handle().record(static_cast<std::size_t>(level), bytes, formatted - start, end - formatted, count);
+				if constexpr (impl::profile_call_sites)
+					profiler::record({fmt.file, fmt.line, {fmt.text.data(), fmt.text.size()}, Self::logger_name, static_cast<std::size_t>(level)},
+						count, bytes, end - start);
+			}
+		}
+
+		template <Level level, typename Trace, typename Range, typename Projector>
+		static void write_batch([[maybe_unused]] const Trace& stacktrace, const Range& range, const Format& fmt, Projector& projector)
+		{
+			fmt::memory_buffer prefix;
+			fmt::text_style _message_style {Self::message_style};
+			format_prefix<level>(std::back_inserter(prefix), _message_style);
+
+			// Symbolizing modules is expensive : the stack trace is formatted once.
+			fmt::memory_buffer suffix;
+			if constexpr (!std::is_same_v<Trace, impl::no_stacktrace>)
+				fmt::format_to(std::back_inserter(suffix), "{}", stacktrace);
+			if constexpr (Self::add_new_line)
+				suffix.push_back('\n');
+
+			write<level>(fmt, [&](auto& out) {
+				std::size_t count {0};
+				for (auto&& element : range)
+				{
+					out.append(prefix.data(), prefix.data() + prefix.size());
+					decltype(auto) arguments = projector(element);
+					if constexpr (impl::is_tuple<std::decay_t<decltype(arguments)>>::value)
+					{
+						std::apply([&](auto&&... args) {
+							format_message(std::back_inserter(out), _message_style, fmt, args...);
+						}, arguments);
+					}
+					else
+					{
+						format_message(std::back_inserter(out), _message_style, fmt, arguments);
+					}
+					out.append(suffix.data(), suffix.data() + suffix.size());
+					count++;
+				}
+				return count;
+			});
+		}
+
+		template <Level level, typename OutputIt, typename Trace, typename... Args>
+		static OutputIt format_with(OutputIt out, [[maybe_unused]] const Trace& stacktrace, fmt::string_view fmt, Args&&... args)
+		{
+			fmt::text_style _message_style {Self::message_style};
+			out = format_prefix<level>(out, _message_style);
+			out = format_message(out, _message_style, fmt, std::forward<Args>(args)...);
+
+			// --- STACKTRACE ---
+			if constexpr (!std::is_same_v<Trace, impl::no_stacktrace>)
+				out = fmt::format_to(out, "{}", stacktrace);
+			return out;
+		}
+
+		/**
+		 * \brief Formats time, logger's name and level into \c out, and sets the style messages are formatted with.
+		 */
+		template <Level level, typename OutputIt>
+		static OutputIt format_prefix(OutputIt out, [[maybe_unused]] fmt::text_style& _message_style)
+		{
 			// --- TIME ---
 			if constexpr (Self::show_time)
 			{
@@ -510,9 +1034,11 @@ slog_assert(my_logger, false, "Abort if false {}", arg);
 					fmt::bg(Self::time_bg) | fmt::fg(Self::time_fg) :
 					fmt::fg(Self::time_fg)
 				};
-				std::time_t now = std::time(nullptr);
-				fmt::format_to(std::back_inserter(out), time_style, Self::time_format, fmt::localtime(now));
-				fmt::format_to(std::back_inserter(out), " ");
+				const auto since_epoch = slog::now(Self::clock).time_since_epoch();
+				const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+				const std::time_t now = static_cast<std::time_t>(seconds.count());
+				out = fmt::format_to(out, time_style, Self::time_format, fmt::localtime(now), (since_epoch - seconds).count());
+				*out++ = ' ';
 			}
 
 			// --- LOGGER ---
@@ -522,12 +1048,11 @@ slog_assert(my_logger, false, "Abort if false {}", arg);
 					fmt::bg(Self::logger_bg) | fmt::fg(Self::logger_fg) :
 					fmt::fg(Self::logger_fg)
 				};
-				fmt::format_to(std::back_inserter(out), logger_style, Self::logger_format, Self::logger_name);
-				fmt::format_to(std::back_inserter(out), " ");
+				out = fmt::format_to(out, logger_style, Self::logger_format, Self::logger_name);
+				*out++ = ' ';
 			}
 
 			// --- CATEGORY ---
-			fmt::text_style _message_style {Self::message_style};
 			if constexpr (Self::show_level)
 			{
 				if constexpr (level == Level::Fatal)
@@ -554,21 +1079,64 @@ slog_assert(my_logger, false, "Abort if false {}", arg);
 				{
 					PRIVATE_SLOG_GEN_CAT_BODY(out, _message_style, debug, "DEBUG");
 				}
-				fmt::format_to(std::back_inserter(out), " ");
+				*out++ = ' ';
 			}
 
-			if constexpr (Self::use_message_style)
+			return out;
+		}
+
+		template <typename OutputIt, typename... Args>
+		static OutputIt format_message(OutputIt out, [[maybe_unused]] const fmt::text_style& _message_style, fmt::string_view fmt, Args&&... args)
+		{
+			// --- MESSAGE ---
+			if constexpr (Self::max_message_size == 0)
 			{
-				fmt::format_to(std::back_inserter(out), _message_style, fmt, std::forward<Args>(args)...);
+				if constexpr (Self::use_message_style)
+					out = fmt::format_to(out, _message_style, fmt, std::forward<Args>(args)...);
+				else
+					out = fmt::format_to(out, fmt::runtime(fmt), std::forward<Args>(args)...);
 			}
 			else
 			{
-				fmt::format_to(std::back_inserter(out), fmt::runtime(fmt), std::forward<Args>(args)...);
+				// Characters past max_message_size are counted but never stored.
+				bool truncated {false};
+				if constexpr (Self::use_message_style)
+				{
+					fmt::memory_buffer message;
+					const auto result = fmt::format_to_n(impl::Utf8Writer{std::back_inserter(message)}, Self::max_message_size,
+						fmt::runtime(fmt), std::forward<Args>(args)...);
+					truncated = result.size > Self::max_message_size;
+					auto message_out = result.out;
+					message_out.finish(truncated);
+					out = fmt::format_to(out, _message_style, "{}", fmt::string_view{message.data(), message.size()});
+				}
+				else
+				{
+					const auto result = fmt::format_to_n(impl::Utf8Writer{out}, Self::max_message_size, fmt::runtime(fmt), std::forward<Args>(args)...);
+					truncated = result.size > Self::max_message_size;
+					auto message_out = result.out;
+					out = message_out.finish(truncated);
+				}
+				if (truncated)
+				{
+					const std::string_view marker {Self::truncation_marker};
+					out = std::copy(marker.begin(), marker.end(), out);
+				}
 			}
-			return {out.data(), out.size()};
-#else
-			return {};
-#endif
+
+			return out;
+		}
+
+		static Counters& counters()
+		{
+			static Counters counters;
+			return counters;
+		}
+
+		static Counters::Handle& counters_handle()
+		{
+			thread_local Counters::Handle handle {counters()};
+			return handle;
 		}
 	};
 
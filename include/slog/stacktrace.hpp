@@ -0,0 +1,106 @@
+/*****************************************************************//**
+ * @file   stacktrace.hpp
+ * @brief  Header file - Defines a cheap stack trace capture, symbolized offline.
+ *
+ * Only return addresses are captured. Each frame is printed with the module it belongs to and
+ * the offset, in this module, of the call instruction, so that it can be symbolized later, e.g. :
+ * \code
+ * addr2line -f -C -i -e <module> <offset>
+ * \endcode
+ * Offsets of a non-relocatable executable (built without -pie) are absolute addresses, as
+ * expected by @c addr2line.
+ *
+ * Supported on platforms providing @c backtrace (glibc, macOS) and on Windows. Elsewhere, stack
+ * traces are empty. When @c SLOG_FRAME_POINTERS is defined (cmake -DSLOG_FRAME_POINTERS=ON), frames are
+ * found by following frame pointers instead, on x86-64 and AArch64 Linux and macOS : much cheaper, but
+ * the trace stops at the first function built without them (see -fno-omit-frame-pointer).
+ *
+ * Frames are symbolized by tools/symbolize.py, reading logs on its standard input.
+ *
+ * Usage :
+\code{.cpp}
+struct my_logger : public slog::Logger<my_logger>
+{
+	static constexpr bool show_stacktrace {true};                 // Append a stack trace to messages ...
+	static constexpr slog::Level stacktrace_level {slog::Level::Error}; // ... at least this severe.
+};
+
+// Or manually
+fmt::print("{}", slog::capture_stacktrace());
+\endcode
+ *********************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <fmt/format.h>
+
+namespace slog
+{
+    inline constexpr std::size_t max_stacktrace_frames{64};
+
+    /**
+     * @brief Return addresses of a thread's call stack, innermost first.
+     */
+    struct Stacktrace
+    {
+        void *frames[max_stacktrace_frames];
+        std::size_t size{0};
+    };
+
+    /**
+     * @brief Module a frame belongs to. Offsets are relative to @c base, null for a non-relocatable
+     * executable.
+     */
+    struct Module
+    {
+        const char *path{nullptr};
+        const void *base{nullptr};
+    };
+
+    /**
+     * @brief Captures the calling thread's return addresses, skipping @c skip innermost frames
+     * (not counting this function). Nothing is symbolized.
+     */
+    Stacktrace capture_stacktrace(std::size_t skip = 0);
+
+    /**
+     * @brief Returns the module containing @c address, or an empty module if unknown.
+     *
+     * Module's path stays valid at least until the next call from the same thread.
+     */
+    Module find_module(const void *address);
+} // namespace slog
+
+/**
+ * \brief Formats a stack trace, one frame per line : index, address, module and offset.
+ *
+ * Every frame holds a return address, which may already belong to the next line or function : offsets
+ * point one byte before, inside the call instruction.
+ */
+template <> struct fmt::formatter<slog::Stacktrace>
+{
+    constexpr auto parse(format_parse_context &ctx) -> decltype(ctx.begin())
+    {
+        return ctx.begin();
+    }
+
+    template <typename FormatContext>
+    auto format(const slog::Stacktrace &stacktrace, FormatContext &ctx) const -> decltype(ctx.out())
+    {
+        auto out = ctx.out();
+        for (std::size_t i = 0; i < stacktrace.size; i++)
+        {
+            const void *address = stacktrace.frames[i];
+            const slog::Module module = slog::find_module(address);
+            if (module.path != nullptr)
+                out = fmt::format_to(out, "\n    #{:<2} {} {}+{:#x}", i, address, module.path,
+                                     reinterpret_cast<std::uintptr_t>(address) - 1 -
+                                         reinterpret_cast<std::uintptr_t>(module.base));
+            else
+                out = fmt::format_to(out, "\n    #{:<2} {}", i, address);
+        }
+        return out;
+    }
+};
@@ -0,0 +1,204 @@
+/*****************************************************************//**
+ * @file   stats.hpp
+ * @brief  Header file - Defines counters a logger uses to measure its own cost.
+ *
+ * Counters are only updated when a logger sets @c collect_stats to true.
+ *
+ * Usage :
+\code{.cpp}
+struct my_logger : public slog::Logger<my_logger>
+{
+	static constexpr bool collect_stats {true};
+};
+
+// Every few seconds, e.g. from a monitoring thread
+static slog::StatsReporter reporter {"my_logger", &my_logger::stats};
+reporter.report(); // Compares the last interval to the previous one
+
+// Or manually
+slog::Stats total = slog::stats(); // Sum of all loggers
+\endcode
+ *********************************************************************/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace slog
+{
+    /**
+     * @brief Number of levels, see @c slog::Level.
+     */
+    inline constexpr std::size_t level_count{6};
+
+    /**
+     * @brief Snapshot of a logger's counters. Messages are indexed by @c slog::Level.
+     */
+    struct Stats
+    {
+        std::uint64_t messages[level_count]{};
+        std::uint64_t bytes{0};
+        std::uint64_t format_ns{0};
+        std::uint64_t write_ns{0};
+
+        std::uint64_t total_messages() const
+        {
+            std::uint64_t total{0};
+            for (std::uint64_t count : messages)
+                total += count;
+            return total;
+        }
+
+        friend Stats operator-(const Stats &lhs, const Stats &rhs)
+        {
+            Stats delta;
+            for (std::size_t i = 0; i < level_count; i++)
+                delta.messages[i] = lhs.messages[i] - rhs.messages[i];
+            delta.bytes = lhs.bytes - rhs.bytes;
+            delta.format_ns = lhs.format_ns - rhs.format_ns;
+            delta.write_ns = lhs.write_ns - rhs.write_ns;
+            return delta;
+        }
+    };
+
+    /**
+     * @brief Lock-free counters updated by a logger on each message.
+     *
+     * Each thread writes to its own slot, found through a thread-local @c Handle, so logging from
+     * several threads never contends on a shared counter. Slots are kept in a lock-free list and
+     * summed by @c snapshot(). A slot released by an exiting thread is reused by the next thread.
+     */
+    class Counters
+    {
+        struct alignas(64) Slot
+        {
+            std::atomic<std::uint64_t> messages[level_count]{};
+            std::atomic<std::uint64_t> bytes{0};
+            std::atomic<std::uint64_t> format_ns{0};
+            std::atomic<std::uint64_t> write_ns{0};
+            std::atomic<bool> in_use{true};
+            Slot *next{nullptr};
+        };
+
+      public:
+        /**
+         * @brief A thread's access to its slot. Only its owner thread writes to the slot.
+         */
+        class Handle
+        {
+          public:
+            explicit Handle(Counters &counters) : slot{counters.acquire()}
+            {
+            }
+            Handle(Handle const &) = delete;
+            void operator=(Handle const &) = delete;
+            ~Handle()
+            {
+                slot->in_use.store(false, std::memory_order_release);
+            }
+
+            void record(std::size_t level, std::size_t bytes, std::chrono::nanoseconds format_time,
+                        std::chrono::nanoseconds write_time, std::uint64_t count = 1)
+            {
+                add(slot->messages[level], count);
+                add(slot->bytes, bytes);
+                add(slot->format_ns, static_cast<std::uint64_t>(format_time.count()));
+                add(slot->write_ns, static_cast<std::uint64_t>(write_time.count()));
+            }
+
+          private:
+            // Single writer : a plain load and store, no read-modify-write needed.
+            static void add(std::atomic<std::uint64_t> &counter, std::uint64_t value)
+            {
+                counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            }
+
+            Slot *slot;
+        };
+
+        Counters();
+        Counters(Counters const &) = delete;
+        void operator=(Counters const &) = delete;
+
+        Stats snapshot() const
+        {
+            Stats stats;
+            for (const Slot *slot = slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+            {
+                for (std::size_t i = 0; i < level_count; i++)
+                    stats.messages[i] += slot->messages[i].load(std::memory_order_relaxed);
+                stats.bytes += slot->bytes.load(std::memory_order_relaxed);
+                stats.format_ns += slot->format_ns.load(std::memory_order_relaxed);
+                stats.write_ns += slot->write_ns.load(std::memory_order_relaxed);
+            }
+            return stats;
+        }
+
+        /**
+         * @brief Next counters in the list of all loggers' counters, see @c slog::stats().
+         */
+        const Counters *next() const
+        {
+            return next_counters;
+        }
+
+      private:
+        Slot *acquire()
+        {
+            for (Slot *slot = slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+            {
+                bool in_use = false;
+                if (slot->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+                    return slot;
+            }
+
+            // Slots are never freed : they still hold counts of exited threads.
+            Slot *slot = new Slot;
+            slot->next = slots.load(std::memory_order_relaxed);
+            while (!slots.compare_exchange_weak(slot->next, slot, std::memory_order_release,
+                                                std::memory_order_relaxed))
+            {
+            }
+            return slot;
+        }
+
+        std::atomic<Slot *> slots{nullptr};
+        const Counters *next_counters{nullptr};
+    };
+
+    namespace impl
+    {
+        // Counters of every logger, in a lock-free list.
+        inline std::atomic<const Counters *> all_counters{nullptr};
+    } // namespace impl
+
+    inline Counters::Counters()
+    {
+        next_counters = impl::all_counters.load(std::memory_order_relaxed);
+        while (!impl::all_counters.compare_exchange_weak(next_counters, this, std::memory_order_release,
+                                                         std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /**
+     * @brief Returns the sum of all loggers' counters.
+     */
+    inline Stats stats()
+    {
+        Stats total;
+        for (const Counters *counters = impl::all_counters.load(std::memory_order_acquire); counters != nullptr;
+             counters = counters->next())
+        {
+            const Stats stats = counters->snapshot();
+            for (std::size_t i = 0; i < level_count; i++)
+                total.messages[i] += stats.messages[i];
+            total.bytes += stats.bytes;
+            total.format_ns += stats.format_ns;
+            total.write_ns += stats.write_ns;
+        }
+        return total;
+    }
+} // namespace slog
@@ -0,0 +1,147 @@
+#include <slog/clock.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+
+#ifdef PRIVATE_SLOG_CLOCK_TSC
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+    using slog::impl::Calibration;
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+
+    std::int64_t wall_ns()
+    {
+        return duration_cast<nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    bool detect_invariant_tsc()
+    {
+#if defined(PRIVATE_SLOG_CLOCK_TSC) && defined(_MSC_VER) && !defined(__clang__)
+        int registers[4];
+        __cpuid(registers, static_cast<int>(0x80000000));
+        if (static_cast<unsigned int>(registers[0]) < 0x80000007)
+            return false;
+        __cpuid(registers, static_cast<int>(0x80000007));
+        return (static_cast<unsigned int>(registers[3]) & (1u << 8)) != 0;
+#elif defined(PRIVATE_SLOG_CLOCK_TSC)
+        unsigned int eax, ebx, ecx, edx;
+        if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0)
+            return false;
+        return (edx & (1u << 8)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    // Wall-clock time, steady time and ticks sampled at the same instant.
+    struct Sample
+    {
+        std::uint64_t ticks;
+        std::int64_t steady_ns;
+        std::int64_t wall_ns;
+    };
+
+    Sample sample()
+    {
+        Sample sample;
+        sample.ticks = slog::impl::ticks();
+        sample.steady_ns = slog::impl::steady_ns();
+        sample.wall_ns = wall_ns();
+        return sample;
+    }
+
+    constexpr std::int64_t max_slew_ns{duration_cast<nanoseconds>(slog::max_slew).count()};
+
+    // Serializes writers of slog::impl::calibration.
+    std::mutex mutex;
+
+    Calibration first_calibration()
+    {
+        Sample end = sample();
+        Calibration calibration;
+        if (slog::has_invariant_tsc())
+        {
+            // Measure an initial frequency over a short interval, refined on each refresh.
+            const Sample begin = end;
+            while (end.steady_ns - begin.steady_ns < 1'000'000)
+                end = sample();
+            calibration.ns_per_tick = static_cast<double>(end.steady_ns - begin.steady_ns) /
+                                      static_cast<double>(end.ticks - begin.ticks);
+            calibration.period_ticks = static_cast<std::int64_t>(static_cast<double>(slog::impl::period_ns) /
+                                                                 calibration.ns_per_tick);
+        }
+        calibration.steady_ns = end.steady_ns;
+        calibration.steady_wall_ns = end.wall_ns;
+        calibration.ticks = end.ticks;
+        calibration.ticks_wall_ns = end.wall_ns;
+        return calibration;
+    }
+
+    // Anchors a clock at the time the previous calibration predicts, so that it does not jump, and
+    // adjusts its rate to catch up with the system clock by the end of the next period. Larger
+    // differences are stepped.
+    void slew(std::int64_t predicted_ns, std::int64_t wall_ns, double rate, std::int64_t &anchor_ns,
+              double &slewed_rate)
+    {
+        const std::int64_t error = wall_ns - predicted_ns;
+        if (std::llabs(error) > max_slew_ns)
+        {
+            anchor_ns = wall_ns;
+            slewed_rate = rate;
+            return;
+        }
+        anchor_ns = predicted_ns;
+        slewed_rate = rate * (1.0 + static_cast<double>(error) / static_cast<double>(slog::impl::period_ns));
+    }
+} // namespace
+
+void slog::impl::refresh_calibration()
+{
+    std::lock_guard lock{mutex};
+
+    // No write can be in progress while holding the lock.
+    Calibration current;
+    if (!calibration.load(current))
+    {
+        calibration.store(first_calibration());
+        return;
+    }
+
+    // Another thread may have refreshed it while this one was waiting for the lock.
+    const Sample now = sample();
+    const auto elapsed_ticks = static_cast<std::int64_t>(now.ticks - current.ticks);
+    const std::int64_t elapsed_ns = now.steady_ns - current.steady_ns;
+    if (elapsed_ns < period_ns && (current.period_ticks == 0 || elapsed_ticks < current.period_ticks))
+        return;
+
+    Calibration next;
+    next.steady_ns = now.steady_ns;
+    next.ticks = now.ticks;
+    slew(current.steady_wall_ns + static_cast<std::int64_t>(static_cast<double>(elapsed_ns) * current.steady_rate),
+         now.wall_ns, 1.0, next.steady_wall_ns, next.steady_rate);
+    if (current.period_ticks != 0)
+    {
+        const double ns_per_tick = static_cast<double>(elapsed_ns) / static_cast<double>(elapsed_ticks);
+        slew(current.ticks_wall_ns +
+                 static_cast<std::int64_t>(static_cast<double>(elapsed_ticks) * current.ns_per_tick),
+             now.wall_ns, ns_per_tick, next.ticks_wall_ns, next.ns_per_tick);
+        next.period_ticks = static_cast<std::int64_t>(static_cast<double>(period_ns) / ns_per_tick);
+    }
+    calibration.store(next);
+}
+
+bool slog::has_invariant_tsc()
+{
+    static const bool invariant_tsc = detect_invariant_tsc();
+    return invariant_tsc;
+}
@@ -0,0 +1,206 @@
+#include <slog/escape.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define SLOG_ESCAPE_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define SLOG_ESCAPE_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace
+{
+    using find_function = std::size_t (*)(const char *, std::size_t);
+
+    void append(fmt::memory_buffer &out, std::string_view text)
+    {
+        out.append(text.data(), text.data() + text.size());
+    }
+
+    bool is_json_special(unsigned char c)
+    {
+        return c < 0x20 || c == '"' || c == '\\';
+    }
+
+    std::size_t find_json_special_scalar(const char *data, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; i++)
+            if (is_json_special(static_cast<unsigned char>(data[i])))
+                return i;
+        return size;
+    }
+
+#ifdef SLOG_ESCAPE_SSE2
+    unsigned int count_trailing_zeros(unsigned int mask)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned int>(index);
+#else
+        return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+    }
+
+    // A byte needs escaping if it is a quote, a backslash or a control character (<= 0x1F).
+    std::size_t find_json_special_sse2(const char *data, std::size_t size)
+    {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control = _mm_set1_epi8(0x1F);
+
+        std::size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            const __m128i special =
+                _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                             _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+            const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(special));
+            if (mask != 0)
+                return i + count_trailing_zeros(mask);
+        }
+        return i + find_json_special_scalar(data + i, size - i);
+    }
+#endif
+
+#ifdef SLOG_ESCAPE_AVX2
+    __attribute__((target("avx2"))) std::size_t find_json_special_avx2(const char *data,
+                                                                          std::size_t size)
+    {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i control = _mm256_set1_epi8(0x1F);
+
+        std::size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            const __m256i special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+                _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, control), control));
+            const auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(special));
+            if (mask != 0)
+                return i + count_trailing_zeros(mask);
+        }
+        // Clear upper halves before running legacy SSE code, to avoid transition penalties.
+        _mm256_zeroupper();
+        return i + find_json_special_sse2(data + i, size - i);
+    }
+#endif
+
+    find_function select_find_json_special()
+    {
+#if defined(SLOG_ESCAPE_AVX2)
+        if (__builtin_cpu_supports("avx2"))
+            return find_json_special_avx2;
+#endif
+#if defined(SLOG_ESCAPE_SSE2)
+        return find_json_special_sse2;
+#else
+        return find_json_special_scalar;
+#endif
+    }
+
+    // Returns the length of the escape sequence following an ESC character.
+    // Handles CSI sequences (ESC [ parameters intermediates final), as emitted by fmt::text_style,
+    // and two characters sequences otherwise.
+    std::size_t ansi_sequence_length(std::string_view sequence)
+    {
+        if (sequence.empty())
+            return 0;
+        if (sequence[0] != '[')
+            return 1;
+
+        std::size_t i = 1;
+        while (i < sequence.size() && sequence[i] >= 0x20 && sequence[i] <= 0x3F)
+            i++;
+        if (i < sequence.size() && sequence[i] >= 0x40 && sequence[i] <= 0x7E)
+            i++;
+        return i;
+    }
+} // namespace
+
+void slog::strip_ansi(std::string_view in, fmt::memory_buffer &out)
+{
+    // memchr is already vectorized and dispatched at runtime by the C library.
+    while (!in.empty())
+    {
+        const void *escape = std::memchr(in.data(), '\x1b', in.size());
+        if (escape == nullptr)
+        {
+            append(out, in);
+            return;
+        }
+
+        const auto run = static_cast<std::size_t>(static_cast<const char *>(escape) - in.data());
+        append(out, in.substr(0, run));
+        in.remove_prefix(run + 1);
+        in.remove_prefix(ansi_sequence_length(in));
+    }
+}
+
+std::string slog::strip_ansi(std::string_view in)
+{
+    fmt::memory_buffer out;
+    strip_ansi(in, out);
+    return {out.data(), out.size()};
+}
+
+void slog::escape_json(std::string_view in, fmt::memory_buffer &out)
+{
+    static const find_function find_json_special = select_find_json_special();
+
+    while (!in.empty())
+    {
+        const std::size_t run = find_json_special(in.data(), in.size());
+        append(out, in.substr(0, run));
+        if (run == in.size())
+            return;
+
+        const auto c = static_cast<unsigned char>(in[run]);
+        switch (c)
+        {
+        case '"':
+            append(out, "\\\"");
+            break;
+        case '\\':
+            append(out, "\\\\");
+            break;
+        case '\b':
+            append(out, "\\b");
+            break;
+        case '\f':
+            append(out, "\\f");
+            break;
+        case '\n':
+            append(out, "\\n");
+            break;
+        case '\r':
+            append(out, "\\r");
+            break;
+        case '\t':
+            append(out, "\\t");
+            break;
+        default:
+            fmt::format_to(std::back_inserter(out), "\\u{:04x}", c);
+            break;
+        }
+        in.remove_prefix(run + 1);
+    }
+}
+
+std::string slog::escape_json(std::string_view in)
+{
+    fmt::memory_buffer out;
+    escape_json(in, out);
+    return {out.data(), out.size()};
+}
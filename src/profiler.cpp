@@ -0,0 +1,169 @@
+#include <slog/profiler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#include <fmt/format.h>
+
+namespace
+{
+    constexpr const char *overflow_format{"<other call sites>"};
+    constexpr const char *level_names[]{"fatal", "error", "warn", "success", "info", "debug"};
+
+    enum SlotState : int
+    {
+        empty,
+        claiming,
+        ready
+    };
+
+    // Aligned so that no two slots share a cache line : call sites logged from different threads
+    // are counted without false sharing. A slot is claimed once, by the first thread recording its
+    // call site, which copies the format string.
+    struct alignas(64) Slot
+    {
+        std::atomic<int> state{empty};
+        const char *file{""};
+        unsigned line{0};
+        std::string_view logger;
+        std::size_t level{0};
+        std::atomic<std::uint64_t> messages{0};
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> ns{0};
+        char format[slog::profiler::max_format_size + 1]{};
+    };
+
+    Slot slots[slog::profiler::capacity];
+
+    // Gathers call sites not fitting in slots.
+    Slot &overflow_slot()
+    {
+        static Slot &slot = []() -> Slot & {
+            static Slot overflow;
+            std::strcpy(overflow.format, overflow_format);
+            overflow.level = std::size(level_names);
+            overflow.state.store(ready, std::memory_order_release);
+            return overflow;
+        }();
+        return slot;
+    }
+
+    void write_csv_at_exit()
+    {
+        slog::profiler::write_csv(stderr, 20);
+    }
+
+    // Identical file names are not always merged by the linker : they are hashed and compared by content.
+    std::size_t hash_call_site(const slog::profiler::CallSite &site)
+    {
+        std::size_t hash = std::hash<std::string_view>{}(site.file);
+        hash = hash * 31 + std::hash<std::string_view>{}(site.logger);
+        hash = hash * 31 + site.line;
+        return hash * 31 + site.level;
+    }
+
+    bool is_call_site(const Slot &slot, const slog::profiler::CallSite &site)
+    {
+        return slot.line == site.line && slot.level == site.level && slot.logger == site.logger &&
+               (slot.file == site.file || std::strcmp(slot.file, site.file) == 0);
+    }
+
+    // Open addressing : returns the slot of site, claiming a free one if needed.
+    Slot &find_slot(const slog::profiler::CallSite &site)
+    {
+        const std::size_t hash = hash_call_site(site);
+        for (std::size_t probe = 0; probe < slog::profiler::capacity; probe++)
+        {
+            Slot &slot = slots[(hash + probe) % slog::profiler::capacity];
+            int state = slot.state.load(std::memory_order_acquire);
+            if (state == empty && slot.state.compare_exchange_strong(state, claiming, std::memory_order_acquire))
+            {
+                const std::size_t size = std::min(site.format.size(), slog::profiler::max_format_size);
+                std::memcpy(slot.format, site.format.data(), size);
+                slot.format[size] = '\0';
+                slot.file = site.file;
+                slot.line = site.line;
+                slot.logger = site.logger;
+                slot.level = site.level;
+                slot.state.store(ready, std::memory_order_release);
+                return slot;
+            }
+
+            // Another thread is claiming the slot : its call site is known once it is ready.
+            while (state == claiming)
+            {
+                std::this_thread::yield();
+                state = slot.state.load(std::memory_order_acquire);
+            }
+            if (is_call_site(slot, site))
+                return slot;
+        }
+        return overflow_slot();
+    }
+
+    void write_csv_field(std::FILE *stream, std::string_view field)
+    {
+        std::fputc('"', stream);
+        for (char c : field)
+        {
+            if (c == '"')
+                std::fputc('"', stream);
+            std::fputc(c, stream);
+        }
+        std::fputc('"', stream);
+    }
+} // namespace
+
+void slog::profiler::record(const CallSite &site, std::size_t messages, std::size_t bytes,
+                            std::chrono::nanoseconds time)
+{
+    static const bool registered = std::atexit(write_csv_at_exit) == 0;
+    (void)registered;
+
+    Slot &slot = find_slot(site);
+    slot.messages.fetch_add(messages, std::memory_order_relaxed);
+    slot.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    slot.ns.fetch_add(static_cast<std::uint64_t>(time.count()), std::memory_order_relaxed);
+}
+
+std::vector<slog::profiler::Entry> slog::profiler::snapshot()
+{
+    std::vector<Entry> entries;
+    const auto add = [&entries](const Slot &slot) {
+        if (slot.state.load(std::memory_order_acquire) != ready ||
+            slot.messages.load(std::memory_order_relaxed) == 0)
+            return;
+        entries.push_back({slot.file, slot.line, slot.logger, slot.level, slot.format,
+                           slot.messages.load(std::memory_order_relaxed),
+                           slot.bytes.load(std::memory_order_relaxed),
+                           slot.ns.load(std::memory_order_relaxed)});
+    };
+    for (const Slot &slot : slots)
+        add(slot);
+    add(overflow_slot());
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &lhs, const Entry &rhs) { return lhs.ns > rhs.ns; });
+    return entries;
+}
+
+void slog::profiler::write_csv(std::FILE *stream, std::size_t count)
+{
+    const std::vector<Entry> entries = snapshot();
+
+    fmt::print(stream, "location,logger,level,messages,bytes,total_ns,ns_per_message,format\n");
+    for (std::size_t i = 0; i < std::min(count, entries.size()); i++)
+    {
+        const Entry &entry = entries[i];
+        write_csv_field(stream, *entry.file != '\0' ? fmt::format("{}:{}", entry.file, entry.line) : "");
+        std::fputc(',', stream);
+        write_csv_field(stream, entry.logger);
+        fmt::print(stream, ",{},{},{},{},{},", entry.level < std::size(level_names) ? level_names[entry.level] : "",
+                   entry.messages, entry.bytes, entry.ns, entry.messages != 0 ? entry.ns / entry.messages : 0);
+        write_csv_field(stream, entry.format);
+        std::fputc('\n', stream);
+    }
+}
@@ -36,8 +36,43 @@ void slog::NumericalConsoleReporter::add_line(const char *name, float begin, flo
     line_count++;
 }
 
-void slog::NumericalConsoleReporter::print()
+void slog::NumericalConsoleReporter::add_stats(const Stats &begin, const Stats &end)
+{
+    static constexpr const char *level_names[level_count]{
+        "Fatal messages", "Error messages", "Warn messages",
+        "Success messages", "Info messages", "Debug messages"};
+
+    for (std::size_t i = 0; i < level_count; i++)
+        add_line(level_names[i], static_cast<float>(begin.messages[i]),
+                 static_cast<float>(end.messages[i]));
+    add_line("Bytes written", static_cast<float>(begin.bytes), static_cast<float>(end.bytes));
+    add_line("Formatting time (ms)", static_cast<float>(begin.format_ns) / 1e6f,
+             static_cast<float>(end.format_ns) / 1e6f);
+    add_line("Write time (ms)", static_cast<float>(begin.write_ns) / 1e6f,
+             static_cast<float>(end.write_ns) / 1e6f);
+}
+
+void slog::NumericalConsoleReporter::print(std::FILE *stream)
 {
     fmt::format_to(std::back_inserter(out), fmt::emphasis::bold, " {:─^80} ", "");
-    fmt::print("{}\n", std::string{out.data(), out.size()});
+    fmt::print(stream, "{}\n", std::string{out.data(), out.size()});
+}
+
+slog::StatsReporter::StatsReporter(const char *name, Stats (*snapshot)())
+    : title{name}, source{snapshot}, last{snapshot()}
+{
+}
+
+slog::Stats slog::StatsReporter::report(std::FILE *stream)
+{
+    const Stats current = source();
+    const Stats delta = current - last;
+
+    auto ncr = NumericalConsoleReporter(title);
+    ncr.add_stats(last_delta, delta);
+    ncr.print(stream);
+
+    last = current;
+    last_delta = delta;
+    return delta;
 }
@@ -0,0 +1,147 @@
+#include <slog/stacktrace.hpp>
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#define SLOG_STACKTRACE_WINDOWS
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__has_include)
+#if __has_include(<execinfo.h>) && __has_include(<dlfcn.h>)
+#define SLOG_STACKTRACE_EXECINFO
+#include <dlfcn.h>
+#include <execinfo.h>
+#if __has_include(<link.h>)
+#define SLOG_STACKTRACE_ELF
+#include <link.h>
+#endif
+#endif
+#endif
+
+#if defined(SLOG_FRAME_POINTERS) && defined(__GNUC__) && (defined(__x86_64__) || defined(__aarch64__)) &&          \
+    (defined(__linux__) || defined(__APPLE__))
+#define SLOG_STACKTRACE_FRAME_POINTERS
+#include <pthread.h>
+
+namespace
+{
+    struct StackBounds
+    {
+        std::uintptr_t low{0};
+        std::uintptr_t high{0};
+    };
+
+    // Bounds of the calling thread's stack : a frame chain broken by a function built without frame
+    // pointers is never followed outside of it.
+    StackBounds current_stack()
+    {
+        StackBounds bounds;
+#if defined(__APPLE__)
+        const pthread_t thread = pthread_self();
+        bounds.high = reinterpret_cast<std::uintptr_t>(pthread_get_stackaddr_np(thread));
+        bounds.low = bounds.high - pthread_get_stacksize_np(thread);
+#else
+        pthread_attr_t attributes;
+        if (pthread_getattr_np(pthread_self(), &attributes) == 0)
+        {
+            void *address = nullptr;
+            std::size_t size = 0;
+            if (pthread_attr_getstack(&attributes, &address, &size) == 0)
+            {
+                bounds.low = reinterpret_cast<std::uintptr_t>(address);
+                bounds.high = bounds.low + size;
+            }
+            pthread_attr_destroy(&attributes);
+        }
+#endif
+        return bounds;
+    }
+} // namespace
+#endif
+
+slog::Stacktrace slog::capture_stacktrace(std::size_t skip)
+{
+    Stacktrace stacktrace;
+#if defined(SLOG_STACKTRACE_FRAME_POINTERS)
+    // Each frame record holds the caller's frame pointer, then the return address : this function's
+    // one returns to the caller's frame.
+    thread_local const StackBounds stack = current_stack();
+    auto frame = reinterpret_cast<std::uintptr_t>(__builtin_frame_address(0));
+    while (stacktrace.size < max_stacktrace_frames && frame >= stack.low && frame + 2 * sizeof(void *) <= stack.high &&
+           frame % sizeof(void *) == 0)
+    {
+        void *const *record = reinterpret_cast<void *const *>(frame);
+        if (record[1] == nullptr)
+            break;
+        if (skip > 0)
+            skip--;
+        else
+            stacktrace.frames[stacktrace.size++] = record[1];
+
+        // Stacks grow downwards : callers' frames are at higher addresses.
+        const auto next = reinterpret_cast<std::uintptr_t>(record[0]);
+        if (next <= frame)
+            break;
+        frame = next;
+    }
+#elif defined(SLOG_STACKTRACE_WINDOWS)
+    skip++; // This function's frame.
+    stacktrace.size = RtlCaptureStackBackTrace(static_cast<DWORD>(skip),
+                                               static_cast<DWORD>(max_stacktrace_frames),
+                                               stacktrace.frames, nullptr);
+#elif defined(SLOG_STACKTRACE_EXECINFO)
+    skip++; // This function's frame.
+    void *frames[max_stacktrace_frames];
+    const std::size_t size = static_cast<std::size_t>(backtrace(frames, static_cast<int>(max_stacktrace_frames)));
+#if defined(__GNUC__)
+    // Interposed backtrace implementations (e.g. sanitizers) add frames : start at the caller's one.
+    const void *caller = __builtin_return_address(0);
+    const std::size_t caller_index = static_cast<std::size_t>(std::find(frames, frames + size, caller) - frames);
+    if (caller_index < size)
+        skip += caller_index - 1;
+#endif
+    for (std::size_t i = skip; i < size; i++)
+        stacktrace.frames[stacktrace.size++] = frames[i];
+#else
+    (void)skip;
+#endif
+    return stacktrace;
+}
+
+slog::Module slog::find_module(const void *address)
+{
+    Module module;
+#if defined(SLOG_STACKTRACE_WINDOWS)
+    HMODULE handle = nullptr;
+    if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                           static_cast<LPCSTR>(address), &handle))
+    {
+        thread_local char path[MAX_PATH];
+        if (GetModuleFileNameA(handle, path, MAX_PATH) != 0)
+        {
+            module.path = path;
+            module.base = handle;
+        }
+    }
+#elif defined(SLOG_STACKTRACE_EXECINFO)
+    Dl_info info;
+    if (dladdr(address, &info) != 0 && info.dli_fname != nullptr)
+    {
+        module.path = info.dli_fname;
+        module.base = info.dli_fbase;
+#ifdef SLOG_STACKTRACE_ELF
+        // A non-relocatable executable is symbolized from absolute addresses.
+        if (static_cast<const ElfW(Ehdr) *>(info.dli_fbase)->e_type == ET_EXEC)
+            module.base = nullptr;
+#endif
+    }
+#else
+    (void)address;
+#endif
+    return module;
+}
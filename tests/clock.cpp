@@ -0,0 +1,53 @@
+#include <doctest/doctest.h>
+#include <slog/clock.hpp>
+#include <slog/slog.hpp>
+
+#include <chrono>
+#include <cstdlib>
+
+TEST_CASE("Clocks")
+{
+    using namespace std::chrono;
+
+    for (const slog::Clock clock : {slog::Clock::wall, slog::Clock::steady, slog::Clock::tsc})
+    {
+        // Every clock reports wall-clock time.
+        const auto system = time_point_cast<nanoseconds>(system_clock::now());
+        const slog::timestamp now = slog::now(clock);
+        CHECK(std::abs(duration_cast<milliseconds>(now - system).count()) < 100);
+    }
+
+    // Calibrated clocks never go backwards, including across refreshes.
+    const auto end = steady_clock::now() + 2 * slog::calibration_period + milliseconds{100};
+    slog::timestamp previous_steady = slog::now(slog::Clock::steady);
+    slog::timestamp previous_tsc = slog::now(slog::Clock::tsc);
+    int backwards = 0;
+    while (steady_clock::now() < end)
+    {
+        const slog::timestamp steady = slog::now(slog::Clock::steady);
+        const slog::timestamp tsc = slog::now(slog::Clock::tsc);
+        backwards += (steady < previous_steady) + (tsc < previous_tsc);
+        previous_steady = steady;
+        previous_tsc = tsc;
+    }
+    CHECK(backwards == 0);
+
+    // And still report wall-clock time after a few refreshes.
+    for (const slog::Clock clock : {slog::Clock::steady, slog::Clock::tsc})
+    {
+        const auto system = time_point_cast<nanoseconds>(system_clock::now());
+        CHECK(std::abs(duration_cast<milliseconds>(slog::now(clock) - system).count()) < 100);
+    }
+}
+
+struct tsc_logger : public slog::Logger<tsc_logger>
+{
+	static constexpr std::string_view logger_name {"tsc_logger"};
+	static constexpr slog::Clock clock {slog::Clock::tsc};
+	static constexpr std::string_view time_format {"[{:%H:%M:%S}.{:09}]"};
+};
+
+TEST_CASE("Logger clock")
+{
+    CHECK_NOTHROW(tsc_logger::info("TSC logger - an info message with a nanosecond timestamp"));
+}
@@ -0,0 +1,50 @@
+#include <doctest/doctest.h>
+#include <slog/escape.hpp>
+#include <slog/slog.hpp>
+
+#include <string>
+#include <utility>
+
+TEST_CASE("Strip ANSI escape sequences")
+{
+    CHECK(slog::strip_ansi("") == "");
+    CHECK(slog::strip_ansi("no escape sequence") == "no escape sequence");
+    CHECK(slog::strip_ansi("\x1b[38;2;232;080;069mred\x1b[0m and plain") == "red and plain");
+    CHECK(slog::strip_ansi("two characters \x1b" "csequence") == "two characters sequence");
+    CHECK(slog::strip_ansi("truncated \x1b[38;2") == "truncated ");
+
+    const std::string message = slog::log::to_string<slog::Level::Error>("Default logger - an error message with an argument of value : {}", 5);
+    CHECK(slog::strip_ansi(message) == "[  ERROR] Default logger - an error message with an argument of value : 5");
+}
+
+TEST_CASE("Escape JSON")
+{
+    CHECK(slog::escape_json("") == "");
+    CHECK(slog::escape_json("nothing to escape") == "nothing to escape");
+    CHECK(slog::escape_json("\"quoted\" back\\slash") == "\\\"quoted\\\" back\\\\slash");
+    CHECK(slog::escape_json("line\nfeed\ttab\r") == "line\\nfeed\\ttab\\r");
+    CHECK(slog::escape_json("\x1b[0m") == "\\u001b[0m");
+
+    // Long enough inputs to go through vectorized kernels, special bytes at every position.
+    // Bytes around the control range's boundaries check the unsigned comparison : 0x1F is escaped,
+    // 0x20 and bytes >= 0x80 (signed negative) are not.
+    const std::pair<char, std::string> cases[] {
+        {'"', "\\\""},
+        {'\0', "\\u0000"},
+        {'\x1f', "\\u001f"},
+        {'\x20', " "},
+        {'\x80', "\x80"},
+        {'\xff', "\xff"},
+    };
+    for (const auto& [byte, escaped] : cases)
+    {
+        for (std::size_t position = 0; position < 80; position++)
+        {
+            std::string input(80, 'a');
+            input[position] = byte;
+            std::string expected(80, 'a');
+            expected.replace(position, 1, escaped);
+            CHECK(slog::escape_json(input) == expected);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#include <doctest/doctest.h>
+#include <slog/profiler.hpp>
+#include <slog/slog.hpp>
+#include "utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace
+{
+    slog::Format call_site(slog::Format format) { return format; }
+
+    struct first_logger : slog::Logger<first_logger>
+    {
+        static constexpr std::string_view logger_name {"first"};
+        static std::FILE* sink() { return temporary_sink<first_logger>(); }
+    };
+
+    struct second_logger : slog::Logger<second_logger>
+    {
+        static constexpr std::string_view logger_name {"second"};
+        static std::FILE* sink() { return temporary_sink<second_logger>(); }
+    };
+}
+
+TEST_CASE("Profiler")
+{
+    using namespace std::chrono_literals;
+
+    static constexpr slog::profiler::CallSite cheap {"cheap.cpp", 10, "call site {}", "profiled", 4};
+    static constexpr slog::profiler::CallSite expensive {"expensive.cpp", 20, "expensive \"call site\" {}", "profiled", 1};
+
+    slog::profiler::record(cheap, 1, 10, 100ns);
+    slog::profiler::record(cheap, 1, 10, 100ns);
+    slog::profiler::record(expensive, 1, 1000, 5000ns);
+
+    // Other tests may log too, when built with SLOG_PROFILE.
+    const auto entries = slog::profiler::snapshot();
+    const auto find = [&entries](std::string_view file) {
+        return std::find_if(entries.begin(), entries.end(), [file](const auto& entry) { return entry.file == file; });
+    };
+    REQUIRE(find(expensive.file) != entries.end());
+    REQUIRE(find(cheap.file) != entries.end());
+    CHECK(find(expensive.file) < find(cheap.file));
+    CHECK(find(expensive.file)->messages == 1);
+    CHECK(find(expensive.file)->level == 1);
+    CHECK(find(cheap.file)->line == 10);
+    CHECK(find(cheap.file)->messages == 2);
+    CHECK(find(cheap.file)->bytes == 20);
+    CHECK(find(cheap.file)->ns == 200);
+
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    slog::profiler::write_csv(file);
+    const std::string content = read_back(file);
+    std::fclose(file);
+    CHECK(content.rfind("location,logger,level,messages,bytes,total_ns,ns_per_message,format\n", 0) == 0);
+    CHECK(content.find("\"expensive.cpp:20\",\"profiled\",error,1,1000,5000,5000,\"expensive \"\"call site\"\" {}\"\n") != std::string::npos);
+}
+
+TEST_CASE("Profiler call sites")
+{
+    using namespace std::chrono_literals;
+
+    // Statements are told apart by their location, even if their format strings are identical.
+    const slog::Format first = call_site("value {}");
+    const slog::Format second = call_site("value {}");
+    CHECK(std::string_view{first.file}.find("profiler.cpp") != std::string_view::npos);
+    CHECK(second.line == first.line + 1);
+
+    // A call site may record several messages at once.
+    const slog::profiler::CallSite grouped {first.file, first.line, "value {}", "grouped", 4};
+    slog::profiler::record(grouped, 3, 30, 300ns);
+    slog::profiler::record({first.file, first.line, "value {}", "grouped", 3}, 1, 10, 100ns);
+    slog::profiler::record({second.file, second.line, "value {}", "grouped", 4}, 1, 10, 100ns);
+
+    // Format strings are copied, so that they outlive the caller's string. Long ones are truncated.
+    {
+        const std::string temporary(1000, 'x');
+        slog::profiler::record({"temporary.cpp", 1, temporary, "profiled", 4}, 1, 1, 1ns);
+    }
+
+    const auto entries = slog::profiler::snapshot();
+    const auto count = [&entries](const char* file, unsigned line) {
+        return std::count_if(entries.begin(), entries.end(), [&](const auto& entry) {
+            return std::string_view{entry.file} == file && entry.line == line;
+        });
+    };
+    CHECK(count(first.file, first.line) == 2);
+    CHECK(count(second.file, second.line) == 1);
+    const auto several = std::find_if(entries.begin(), entries.end(), [&](const auto& entry) {
+        return entry.line == first.line && entry.level == 4 && entry.logger == "grouped";
+    });
+    REQUIRE(several != entries.end());
+    CHECK(several->messages == 3);
+    CHECK(std::any_of(entries.begin(), entries.end(), [](const auto& entry) {
+        return std::string_view{entry.file} == "temporary.cpp" &&
+               std::string_view{entry.format} == std::string(slog::profiler::max_format_size, 'x');
+    }));
+
+#ifdef SLOG_PROFILE
+    // Loggers sharing a format string literal are counted apart.
+    first_logger::info("Profiler - a shared format string {}", 1);
+    second_logger::info("Profiler - a shared format string {}", 2);
+    const auto profiled = slog::profiler::snapshot();
+    CHECK(std::count_if(profiled.begin(), profiled.end(), [](const auto& entry) {
+        return std::string_view{entry.format} == "Profiler - a shared format string {}";
+    }) == 2);
+#endif
+}
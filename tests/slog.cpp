@@ -1,5 +1,14 @@
 #include <doctest/doctest.h>
 #include <slog/slog.hpp>
+#include <slog/reporter.hpp>
+#include "utils.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 TEST_CASE("Default logger")
 {
@@ -49,3 +58,288 @@ TEST_CASE("Macros")
 	// An assert is also provided, that abort if condition is false
 	slog_assert(my_logger, true, "Will not abort", 13);
 }
+
+struct counted_logger : public slog::Logger<counted_logger>
+{
+	static constexpr std::string_view logger_name {"counted_logger"};
+	static constexpr bool collect_stats {true};
+};
+
+TEST_CASE("Stats")
+{
+    CHECK(slog::log::stats().total_messages() == 0);
+
+    const slog::Stats before = counted_logger::stats();
+    counted_logger::info("Counted logger - an info message with an argument of value : {}", 1);
+    counted_logger::info("Counted logger - an info message with an argument of value : {}", 2);
+    counted_logger::error("Counted logger - an error message with an argument of value : {}", 3);
+    const slog::Stats delta = counted_logger::stats() - before;
+
+    CHECK(delta.total_messages() == 3);
+    CHECK(delta.messages[static_cast<std::size_t>(slog::Level::Info)] == 2);
+    CHECK(delta.messages[static_cast<std::size_t>(slog::Level::Error)] == 1);
+    CHECK(delta.bytes == counted_logger::to_string<slog::Level::Info>("Counted logger - an info message with an argument of value : {}", 1).size()
+                       + counted_logger::to_string<slog::Level::Info>("Counted logger - an info message with an argument of value : {}", 2).size()
+                       + counted_logger::to_string<slog::Level::Error>("Counted logger - an error message with an argument of value : {}", 3).size()
+                       + 3);
+}
+
+TEST_CASE("Stats from several threads")
+{
+    const slog::Stats before = counted_logger::stats();
+    const slog::Stats total_before = slog::stats();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+        threads.emplace_back([t] {
+            for (int i = 0; i < 10; i++)
+                counted_logger::debug("Counted logger - thread {} - message {}", t, i);
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // Slots of exited threads still count.
+    CHECK((counted_logger::stats() - before).messages[static_cast<std::size_t>(slog::Level::Debug)] == 40);
+    CHECK((slog::stats() - total_before).total_messages() == 40);
+}
+
+TEST_CASE("Stats reporter")
+{
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    slog::StatsReporter reporter {"counted_logger", &counted_logger::stats};
+
+    counted_logger::info("Counted logger - first interval - message {}", 1);
+    counted_logger::info("Counted logger - first interval - message {}", 2);
+    const slog::Stats first = reporter.report(file);
+    const std::string first_report = read_back(file);
+
+    counted_logger::info("Counted logger - second interval - message {}", 1);
+    counted_logger::info("Counted logger - second interval - message {}", 2);
+    counted_logger::info("Counted logger - second interval - message {}", 3);
+    counted_logger::warn("Counted logger - second interval - message {}", 4);
+    const slog::Stats second = reporter.report(file);
+    const std::string second_report = read_back(file).substr(first_report.size());
+    std::fclose(file);
+
+    // Each report shows the deltas of its interval, next to the previous interval's ones.
+    CHECK(first.total_messages() == 2);
+    CHECK(second.messages[static_cast<std::size_t>(slog::Level::Info)] == 3);
+    CHECK(second.messages[static_cast<std::size_t>(slog::Level::Warn)] == 1);
+    CHECK(second.total_messages() == 4);
+
+    const auto line = [](const std::string& report, const char* label) {
+        const std::size_t begin = report.find(label);
+        return begin != std::string::npos ? report.substr(begin, report.find('\n', begin) - begin) : std::string{};
+    };
+    const std::string info = line(second_report, "Info messages");
+    CHECK(info.find(fmt::format("{:^12}", 2.f)) != std::string::npos);
+    CHECK(info.find(fmt::format("{:^12}", 3.f)) != std::string::npos);
+    const std::string warn = line(second_report, "Warn messages");
+    CHECK(warn.find(fmt::format("{:^12}", 0.f)) != std::string::npos);
+    CHECK(warn.find(fmt::format("{:^12}", 1.f)) != std::string::npos);
+    CHECK(line(first_report, "Info messages").find(fmt::format("{:^12}", 2.f)) != std::string::npos);
+}
+
+struct file_logger : public slog::Logger<file_logger>
+{
+	static constexpr bool show_time {false};
+	static constexpr bool show_logger_name {false};
+	static constexpr bool show_level {false};
+
+	static std::FILE* sink()
+	{
+		return temporary_sink<file_logger>();
+	}
+};
+
+TEST_CASE("Custom sink")
+{
+    REQUIRE(file_logger::sink() != nullptr);
+
+    file_logger::info("first message {}", 1);
+    file_logger::warn("second message {}", 2);
+    CHECK(read_back(file_logger::sink()) == "first message 1\nsecond message 2\n");
+}
+
+struct streaming_logger : public slog::Logger<streaming_logger>
+{
+	static constexpr bool show_time {false};
+	static constexpr bool show_logger_name {false};
+	static constexpr bool show_level {false};
+	static constexpr bool stream_messages {true};
+	static constexpr std::size_t chunk_size {16};
+
+	static std::FILE* sink()
+	{
+		return temporary_sink<streaming_logger>();
+	}
+};
+
+struct concurrent_streaming_logger : public slog::Logger<concurrent_streaming_logger>
+{
+	static constexpr bool show_time {false};
+	static constexpr bool show_logger_name {false};
+	static constexpr bool show_level {false};
+	static constexpr bool stream_messages {true};
+	static constexpr std::size_t chunk_size {16};
+
+	static std::FILE* sink()
+	{
+		return temporary_sink<concurrent_streaming_logger>();
+	}
+};
+
+struct truncating_logger : public slog::Logger<truncating_logger>
+{
+	static constexpr bool show_time {false};
+	static constexpr bool show_logger_name {false};
+	static constexpr bool show_level {false};
+	static constexpr std::size_t max_message_size {10};
+};
+
+TEST_CASE("Large messages")
+{
+    REQUIRE(streaming_logger::sink() != nullptr);
+
+    const std::string payload(1000, 'x');
+    streaming_logger::info("payload {}", payload);
+    CHECK(read_back(streaming_logger::sink()) == "payload " + payload + "\n");
+
+    CHECK(truncating_logger::to_string<slog::Level::Info>("short") == "short");
+    CHECK(truncating_logger::to_string<slog::Level::Info>("exactly {}", "10") == "exactly 10");
+    CHECK(truncating_logger::to_string<slog::Level::Info>("payload {}", payload) == "payload xx [...]");
+
+    // Truncation never cuts a code point.
+    CHECK(truncating_logger::to_string<slog::Level::Info>("{}", "12345678\xc3\xa9") == "12345678\xc3\xa9");
+    CHECK(truncating_logger::to_string<slog::Level::Info>("{}", "123456789\xc3\xa9") == "123456789 [...]");
+    CHECK(truncating_logger::to_string<slog::Level::Info>("{}", "1234567\xf0\x9f\x93\x9c") == "1234567 [...]");
+}
+
+TEST_CASE("Streamed messages from several threads")
+{
+    REQUIRE(concurrent_streaming_logger::sink() != nullptr);
+
+    std::vector<std::thread> threads;
+    for (char c : {'a', 'b', 'c', 'd'})
+        threads.emplace_back([c] {
+            for (int i = 0; i < 100; i++)
+                concurrent_streaming_logger::info("{}", std::string(1000, c));
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // Messages are longer than a chunk, yet lines are never interleaved.
+    const std::string content = read_back(concurrent_streaming_logger::sink());
+    REQUIRE(content.size() == 400 * 1001);
+    std::size_t interleaved {0};
+    for (std::size_t line = 0; line < 400; line++)
+    {
+        const std::string_view message = std::string_view{content}.substr(line * 1001, 1001);
+        if (message != std::string(1000, message[0]) + "\n")
+            interleaved++;
+    }
+    CHECK(interleaved == 0);
+}
+
+// Formatting is customized by shadowing format_to, or to_string.
+struct quoted_logger : public slog::Logger<quoted_logger>
+{
+	static constexpr bool show_time {false};
+	static constexpr bool show_logger_name {false};
+	static constexpr bool show_level {false};
+	static constexpr bool stream_messages {true};
+
+	template <slog::Level level, typename OutputIt, typename... Args>
+	static OutputIt format_to(OutputIt out, slog::Format fmt, Args&&... args)
+	{
+		*out++ = '>';
+		return slog::Logger<quoted_logger>::format_to<level>(out, fmt, std::forward<Args>(args)...);
+	}
+
+	static std::FILE* sink()
+	{
+		return temporary_sink<quoted_logger>();
+	}
+};
+
+struct shouting_logger : public slog::Logger<shouting_logger>
+{
+	static constexpr bool show_time {false};
+	static constexpr bool show_logger_name {false};
+	static constexpr bool show_level {false};
+
+	template <slog::Level level, typename... Args>
+	static std::string to_string(slog::Format fmt, Args&&... args)
+	{
+		std::string message = slog::Logger<shouting_logger>::to_string<level>(fmt, std::forward<Args>(args)...);
+		std::transform(message.begin(), message.end(), message.begin(), [](char c) { return static_cast<char>(std::toupper(c)); });
+		return message;
+	}
+
+	static std::FILE* sink()
+	{
+		return temporary_sink<shouting_logger>();
+	}
+};
+
+TEST_CASE("Custom formatting")
+{
+    REQUIRE(quoted_logger::sink() != nullptr);
+    REQUIRE(shouting_logger::sink() != nullptr);
+
+    quoted_logger::info("streamed {}", 1);
+    CHECK(quoted_logger::to_string<slog::Level::Info>("formatted {}", 2) == ">formatted 2");
+    CHECK(read_back(quoted_logger::sink()) == ">streamed 1\n");
+
+    shouting_logger::warn("quiet {}", "please");
+    CHECK(read_back(shouting_logger::sink()) == "QUIET PLEASE\n");
+}
+
+struct batch_logger : public slog::Logger<batch_logger>
+{
+	static constexpr std::string_view logger_name {"batch_logger"};
+	static constexpr bool collect_stats {true};
+	static constexpr bool show_time {false};
+	static constexpr bool show_level {false};
+
+	static std::FILE* sink()
+	{
+		return temporary_sink<batch_logger>();
+	}
+};
+
+TEST_CASE("Batch")
+{
+    REQUIRE(batch_logger::sink() != nullptr);
+
+    const std::vector<int> values {4, 8, 15};
+    const slog::Stats before = batch_logger::stats();
+    batch_logger::info_batch(values, "value {}");
+    batch_logger::warn_batch(values, "item {} -> {}", [](int value) { return std::make_tuple(value, value * 2); });
+    batch_logger::debug_batch(std::vector<int>{}, "never {}");
+
+    const slog::Stats delta = batch_logger::stats() - before;
+    CHECK(delta.messages[static_cast<std::size_t>(slog::Level::Info)] == 3);
+    CHECK(delta.messages[static_cast<std::size_t>(slog::Level::Warn)] == 3);
+    CHECK(delta.total_messages() == 6);
+
+    std::string expected;
+    for (int value : values)
+        expected += batch_logger::to_string<slog::Level::Info>("value {}", value) + "\n";
+    for (int value : values)
+        expected += batch_logger::to_string<slog::Level::Warn>("item {} -> {}", value, value * 2) + "\n";
+    CHECK(read_back(batch_logger::sink()) == expected);
+    CHECK(delta.bytes == expected.size());
+}
+
+TEST_CASE("Streamed batch")
+{
+    REQUIRE(streaming_logger::sink() != nullptr);
+    const std::string before = read_back(streaming_logger::sink());
+
+    // Messages longer than a chunk are written chunk by chunk.
+    const std::vector<std::string> values {"first", std::string(100, 'y'), "last"};
+    streaming_logger::info_batch(values, "value {}");
+    CHECK(read_back(streaming_logger::sink()) == before + "value first\nvalue " + values[1] + "\nvalue last\n");
+}
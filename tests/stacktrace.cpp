@@ -0,0 +1,112 @@
+#include <doctest/doctest.h>
+#include <slog/slog.hpp>
+#include <slog/stacktrace.hpp>
+#include "utils.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+TEST_CASE("Stacktrace")
+{
+    const slog::Stacktrace stacktrace = slog::capture_stacktrace();
+    CHECK(stacktrace.size <= slog::max_stacktrace_frames);
+
+    // One line per frame.
+    const std::string formatted = fmt::format("{}", stacktrace);
+    CHECK(static_cast<std::size_t>(std::count(formatted.begin(), formatted.end(), '\n')) == stacktrace.size);
+
+    // Skipped frames are removed from the innermost ones.
+    if (stacktrace.size > 1)
+    {
+        const slog::Stacktrace skipped = slog::capture_stacktrace(1);
+        CHECK(skipped.size == stacktrace.size - 1);
+    }
+}
+
+struct traced_logger : public slog::Logger<traced_logger>
+{
+	static constexpr std::string_view logger_name {"traced_logger"};
+	static constexpr bool show_stacktrace {true};
+	static constexpr slog::Level stacktrace_level {slog::Level::Error};
+
+	static std::FILE* sink()
+	{
+		return temporary_sink<traced_logger>();
+	}
+};
+
+#if defined(__GNUC__)
+// Returns an error message of traced_logger, and the address this function returns to.
+[[gnu::noinline]] static std::string traced_message(const void*& return_address)
+{
+    return_address = __builtin_return_address(0);
+    return traced_logger::to_string<slog::Level::Error>("Traced logger - an error message followed by a stack trace");
+}
+
+// Logs an error message with traced_logger, and returns the address this function returns to.
+[[gnu::noinline]] static const void* traced_log()
+{
+    traced_logger::error("Traced logger - a logged error message followed by a stack trace");
+    return __builtin_return_address(0);
+}
+#endif
+
+TEST_CASE("Logger stacktrace")
+{
+    CHECK_NOTHROW(traced_logger::error("Traced logger - an error message followed by a stack trace"));
+    CHECK(traced_logger::to_string<slog::Level::Warn>("no stack trace").find('\n') == std::string::npos);
+
+#if defined(__GNUC__)
+    if (slog::capture_stacktrace().size > 0)
+    {
+        // Frames start at the function calling the logger : the next one is its caller.
+        const void* return_address {nullptr};
+        const std::string message = traced_message(return_address);
+        CHECK(message.find("\n    #0  0x") != std::string::npos);
+        CHECK(message.find("+0x") != std::string::npos);
+        CHECK(message.find(fmt::format("\n    #1  {} ", return_address)) != std::string::npos);
+
+        // Likewise for logged messages, formatted once the logger's frames are pushed.
+        const std::string before = read_back(traced_logger::sink());
+        const void* logged_return_address = traced_log();
+        const std::string logged = read_back(traced_logger::sink()).substr(before.size());
+        CHECK(logged.find("\n    #0  0x") != std::string::npos);
+        CHECK(logged.find(fmt::format("\n    #1  {} ", logged_return_address)) != std::string::npos);
+    }
+#endif
+}
+
+struct traced_batch_logger : public slog::Logger<traced_batch_logger>
+{
+	static constexpr bool show_time {false};
+	static constexpr bool show_logger_name {false};
+	static constexpr bool show_level {false};
+
+	static std::FILE* sink()
+	{
+		return temporary_sink<traced_batch_logger>();
+	}
+};
+
+TEST_CASE("Batch stacktrace")
+{
+    REQUIRE(traced_batch_logger::sink() != nullptr);
+
+    // Fatal messages show a stack trace by default. Each message of a batch shows the same one.
+    traced_batch_logger::fatal_batch(std::vector<int> {1, 2, 3}, "value {}");
+    traced_batch_logger::info_batch(std::vector<int> {4}, "no stack trace {}");
+    const std::string content = read_back(traced_batch_logger::sink());
+    const std::string stacktrace = fmt::format("{}", slog::capture_stacktrace());
+    if (!stacktrace.empty())
+    {
+        const std::size_t first = content.find("\n    #0 ");
+        REQUIRE(first != std::string::npos);
+        const std::string trace = content.substr(first, content.find("\nvalue 2") - first);
+        CHECK(content == "value 1" + trace + "\nvalue 2" + trace + "\nvalue 3" + trace + "\nno stack trace 4\n");
+    }
+    else
+    {
+        CHECK(content == "value 1\nvalue 2\nvalue 3\nno stack trace 4\n");
+    }
+}
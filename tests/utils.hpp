@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdio>
 #include <string>
 #include <vector>
 
@@ -12,6 +13,25 @@
     });                                                                                         \
     _doctest_subcase_idx = 0
 
+// Sink of a test logger : a temporary file, one per Tag.
+template <typename Tag>
+std::FILE* temporary_sink() {
+    static std::FILE* file = std::tmpfile();
+    return file;
+}
+
+// Returns everything written to stream so far.
+inline std::string read_back(std::FILE* stream) {
+    std::fflush(stream);
+    std::rewind(stream);
+    std::string content;
+    char chunk[4096];
+    for (std::size_t size; (size = std::fread(chunk, 1, sizeof(chunk), stream)) > 0;)
+        content.append(chunk, size);
+    std::fseek(stream, 0, SEEK_END);
+    return content;
+}
+
 // To print vector
 namespace std // NOLINT(cert-dcl58-cpp)
 {
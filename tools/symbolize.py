@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""Symbolizes stack traces printed by slog.
+
+Reads logs on standard input (or from the given files), and writes them to standard output, with each
+"#N address module+offset" frame followed by its functions and source locations, found by addr2line.
+Inlined functions are printed innermost first.
+
+Usage :
+    ./my_program 2>&1 | tools/symbolize.py
+    tools/symbolize.py my_program.log --addr2line llvm-addr2line
+"""
+
+import argparse
+import collections
+import fileinput
+import re
+import subprocess
+import sys
+
+FRAME = re.compile(r"^(?P<indent>\s*)#(?P<index>\d+)\s+(?P<address>0x[0-9a-fA-F]+)\s+(?P<module>.+)\+(?P<offset>0x[0-9a-fA-F]+)\s*$")
+
+
+def symbolize(addr2line, module, offsets):
+    """Returns, for each offset of module, a list of (function, location), innermost inlined function first."""
+    try:
+        output = subprocess.run([addr2line, "-a", "-f", "-C", "-i", "-e", module, *offsets],
+                                check=True, capture_output=True, text=True).stdout
+    except (OSError, subprocess.CalledProcessError):
+        return {}
+
+    # Each address is printed first, then a function and location pair per inlined function.
+    symbols = {}
+    lines = output.splitlines()
+    current = None
+    i = 0
+    while i < len(lines):
+        if lines[i].startswith("0x"):
+            current = int(lines[i], 16)
+            symbols[current] = []
+            i += 1
+        elif current is not None and i + 1 < len(lines):
+            symbols[current].append((lines[i], lines[i + 1]))
+            i += 2
+        else:
+            i += 1
+    return {offset: symbols.get(int(offset, 16), []) for offset in offsets}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="*", help="Logs to symbolize, standard input if none")
+    parser.add_argument("--addr2line", default="addr2line", help="addr2line executable (default: addr2line)")
+    arguments = parser.parse_args()
+
+    # addr2line is run once per module, with all of its offsets.
+    lines = list(fileinput.input(arguments.files))
+    offsets = collections.defaultdict(set)
+    for line in lines:
+        frame = FRAME.match(line)
+        if frame:
+            offsets[frame["module"]].add(frame["offset"])
+    symbols = {module: symbolize(arguments.addr2line, module, sorted(module_offsets))
+               for module, module_offsets in offsets.items()}
+
+    for line in lines:
+        sys.stdout.write(line)
+        frame = FRAME.match(line)
+        if not frame:
+            continue
+        for function, location in symbols[frame["module"]].get(frame["offset"], []):
+            sys.stdout.write(f"{frame['indent']}       {function} at {location}\n")
+
+
+if __name__ == "__main__":
+    main()